@@ -10,6 +10,6 @@ enum ExceptionHandler
     FileFormatException = 4,
     FileOpenException = 5,
     MoveImpossible = 6,
-} globalExceptionHandler;
+};
 
 #endif
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "Territory.h"
+
+// =========================================
+// available public functions:
+
+int territoryBalance(const struct TerritoryScore *score, int playerId);
+
+// =========================================
+
+int territoryBalance(const struct TerritoryScore *score, int playerId)
+{
+    int bestOpponent = 0;
+    for (int id = 0; id <= MAX_PLAYER_ID; id++)
+    {
+        if (id != playerId && score->fishes[id] > bestOpponent)
+            bestOpponent = score->fishes[id];
+    }
+
+    const int ours = playerId >= 0 && playerId <= MAX_PLAYER_ID ? score->fishes[playerId] : 0;
+    return ours - bestOpponent;
+}
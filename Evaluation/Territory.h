@@ -0,0 +1,23 @@
+#ifndef TERRITORY_H
+#define TERRITORY_H
+
+#include "../GameGrid/Grid.h"
+
+// Voronoi-like split of the board: every tile with fish belongs to the player whose penguins
+// can reach it in the smallest number of straight moves (tiles reached first by two players
+// at once belong to nobody). All players are expanded at once, level by level, with every
+// board row stored as a bit mask so that a whole frontier moves with a handful of word operations
+// (see slideFromSources in GameGrid/BoardKernels.h). The engine scores its candidates with
+// Evaluation/TerritoryBatch.h, the one position version in Evaluation/TerritoryReference.h is only
+// built into the TerritoryCheck tool to check it.
+
+struct TerritoryScore
+{
+    int fishes[MAX_PLAYER_ID + 1]; // fish inside the territory of every player id
+    int tiles[MAX_PLAYER_ID + 1];  // number of tiles inside it
+};
+
+// fish in the territory of the given player minus the fish of the best opponent
+int territoryBalance(const struct TerritoryScore *score, int playerId);
+
+#endif
@@ -0,0 +1,219 @@
+#include "TerritoryBatch.h"
+#include "stdlib.h"
+#include "string.h"
+#include "../GameGrid/BoardKernels.h"
+
+// =========================================
+// available public functions:
+
+struct TerritoryBatchEvaluator createTerritoryBatchEvaluatorObject(int rows, int cols);
+void freeTerritoryBatchEvaluatorObject(struct TerritoryBatchEvaluator *evaluator);
+void evaluateTerritoryBatch(struct TerritoryBatchEvaluator *evaluator, const struct GameGrid *gameGrid,
+                            const struct TerritoryCandidate *candidates, int numberOfCandidates, struct TerritoryScore *scores);
+
+// private functions:
+
+// fills the first numberOfLanes lanes with the boards after the candidates and clears the rest,
+// activePlayers tells which player ids have a penguin in any of the lanes
+void loadCandidates(struct TerritoryBatchEvaluator *evaluator, const struct GameGrid *gameGrid,
+                    const struct TerritoryCandidate *candidates, int numberOfLanes, bool *activePlayers);
+void setLaneBit(uint64_t *mask, int words, int lane, const struct GridPoint *point, bool value);
+void countLaneFishes(const struct TerritoryBatchEvaluator *evaluator, const struct GameGrid *gameGrid, const uint64_t *mask,
+                     int *fishes, int *numberOfTiles);
+
+// =========================================
+
+struct TerritoryBatchEvaluator createTerritoryBatchEvaluatorObject(int rows, int cols)
+{
+    struct TerritoryBatchEvaluator obj;
+    obj.rows = rows;
+    obj.cols = cols;
+    obj.words = (cols + 63) / 64;
+
+    const size_t maskSize = (size_t)rows * obj.words * BOARD_KERNEL_LANES;
+
+    obj.through = (uint64_t *)calloc(maskSize, sizeof(uint64_t));
+    obj.unclaimed = (uint64_t *)calloc(maskSize, sizeof(uint64_t));
+    obj.frontiers = (uint64_t *)calloc((MAX_PLAYER_ID + 1) * maskSize, sizeof(uint64_t));
+    obj.reached = (uint64_t *)calloc((MAX_PLAYER_ID + 1) * maskSize, sizeof(uint64_t));
+    obj.seenOnce = (uint64_t *)calloc(maskSize, sizeof(uint64_t));
+    obj.seenTwice = (uint64_t *)calloc(maskSize, sizeof(uint64_t));
+
+    return obj;
+}
+
+void freeTerritoryBatchEvaluatorObject(struct TerritoryBatchEvaluator *evaluator)
+{
+    free(evaluator->through);
+    free(evaluator->unclaimed);
+    free(evaluator->frontiers);
+    free(evaluator->reached);
+    free(evaluator->seenOnce);
+    free(evaluator->seenTwice);
+}
+
+void evaluateTerritoryBatch(struct TerritoryBatchEvaluator *evaluator, const struct GameGrid *gameGrid,
+                            const struct TerritoryCandidate *candidates, int numberOfCandidates, struct TerritoryScore *scores)
+{
+    const size_t maskSize = (size_t)evaluator->rows * evaluator->words * BOARD_KERNEL_LANES;
+
+    for (int first = 0; first < numberOfCandidates; first += BOARD_KERNEL_LANES)
+    {
+        const int numberOfLanes = numberOfCandidates - first < BOARD_KERNEL_LANES ? numberOfCandidates - first : BOARD_KERNEL_LANES;
+
+        bool activePlayers[MAX_PLAYER_ID + 1];
+        loadCandidates(evaluator, gameGrid, candidates + first, numberOfLanes, activePlayers);
+        memset(scores + first, 0, numberOfLanes * sizeof(struct TerritoryScore));
+
+        bool anyFrontier = false;
+        for (int id = 0; id <= MAX_PLAYER_ID; id++)
+            anyFrontier |= activePlayers[id];
+
+        // the same levels as in evaluateTerritory, a lane which has finished just keeps empty frontiers
+        while (anyFrontier)
+        {
+            memset(evaluator->seenOnce, 0, maskSize * sizeof(uint64_t));
+            memset(evaluator->seenTwice, 0, maskSize * sizeof(uint64_t));
+
+            for (int id = 0; id <= MAX_PLAYER_ID; id++)
+            {
+                if (!activePlayers[id])
+                    continue;
+
+                uint64_t *reached = evaluator->reached + id * maskSize;
+                gameGrid->kernels->slideFromSourcesLanes(evaluator->rows, evaluator->cols, evaluator->words,
+                                                         evaluator->frontiers + id * maskSize, evaluator->through, reached);
+
+                for (size_t k = 0; k < maskSize; k++)
+                {
+                    reached[k] &= evaluator->unclaimed[k];
+                    evaluator->seenTwice[k] |= evaluator->seenOnce[k] & reached[k];
+                    evaluator->seenOnce[k] |= reached[k];
+                }
+            }
+
+            anyFrontier = false;
+            for (int id = 0; id <= MAX_PLAYER_ID; id++)
+            {
+                if (!activePlayers[id])
+                    continue;
+
+                uint64_t *frontier = evaluator->frontiers + id * maskSize;
+                const uint64_t *reached = evaluator->reached + id * maskSize;
+
+                uint64_t any = 0;
+                for (size_t k = 0; k < maskSize; k++)
+                {
+                    frontier[k] = reached[k] & ~evaluator->seenTwice[k];
+                    any |= frontier[k];
+                }
+
+                if (any)
+                {
+                    int fishes[BOARD_KERNEL_LANES], numberOfTiles[BOARD_KERNEL_LANES];
+                    countLaneFishes(evaluator, gameGrid, frontier, fishes, numberOfTiles);
+                    for (int l = 0; l < numberOfLanes; l++)
+                    {
+                        scores[first + l].fishes[id] += fishes[l];
+                        scores[first + l].tiles[id] += numberOfTiles[l];
+                    }
+                    anyFrontier = true;
+                }
+            }
+
+            for (size_t k = 0; k < maskSize; k++)
+            {
+                evaluator->unclaimed[k] &= ~evaluator->seenOnce[k];
+            }
+        }
+    }
+}
+
+void loadCandidates(struct TerritoryBatchEvaluator *evaluator, const struct GameGrid *gameGrid,
+                    const struct TerritoryCandidate *candidates, int numberOfLanes, bool *activePlayers)
+{
+    const int words = evaluator->words;
+    const size_t boardSize = (size_t)evaluator->rows * words;
+    const size_t maskSize = boardSize * BOARD_KERNEL_LANES;
+
+    for (int id = 0; id <= MAX_PLAYER_ID; id++)
+        activePlayers[id] = gameGrid->numberOfPenguinsOf[id] > 0;
+    for (int l = 0; l < numberOfLanes; l++)
+    {
+        if (candidates[l].playerId >= 0 && candidates[l].playerId <= MAX_PLAYER_ID)
+            activePlayers[candidates[l].playerId] = true;
+    }
+
+    // every lane starts as a copy of the current board
+    for (size_t w = 0; w < boardSize; w++)
+    {
+        for (int l = 0; l < BOARD_KERNEL_LANES; l++)
+            evaluator->through[w * BOARD_KERNEL_LANES + l] = l < numberOfLanes ? gameGrid->fishMasks[0][w] : 0;
+    }
+
+    for (int id = 0; id <= MAX_PLAYER_ID; id++)
+    {
+        if (!activePlayers[id])
+            continue;
+
+        uint64_t *frontier = evaluator->frontiers + id * maskSize;
+        for (size_t w = 0; w < boardSize; w++)
+        {
+            for (int l = 0; l < BOARD_KERNEL_LANES; l++)
+                frontier[w * BOARD_KERNEL_LANES + l] = l < numberOfLanes ? gameGrid->penguinMasks[id][w] : 0;
+        }
+    }
+
+    // then the tiles changed by its candidate, the same way makePlacement and makeMove change them
+    for (int l = 0; l < numberOfLanes; l++)
+    {
+        const struct TerritoryCandidate *candidate = &candidates[l];
+        const bool validPlayer = candidate->playerId >= 0 && candidate->playerId <= MAX_PLAYER_ID;
+        uint64_t *frontier = evaluator->frontiers + (validPlayer ? candidate->playerId : 0) * maskSize;
+
+        if (candidate->from != NULL)
+        {
+            setLaneBit(evaluator->through, words, l, candidate->from, false);
+            if (validPlayer)
+                setLaneBit(frontier, words, l, candidate->from, false);
+        }
+
+        setLaneBit(evaluator->through, words, l, candidate->to, false);
+        if (validPlayer)
+            setLaneBit(frontier, words, l, candidate->to, true);
+    }
+
+    memcpy(evaluator->unclaimed, evaluator->through, maskSize * sizeof(uint64_t));
+}
+
+void setLaneBit(uint64_t *mask, int words, int lane, const struct GridPoint *point, bool value)
+{
+    const uint64_t bit = (uint64_t)1 << (point->y % 64);
+    uint64_t *word = &mask[(point->x * words + point->y / 64) * BOARD_KERNEL_LANES + lane];
+    *word = value ? *word | bit : *word & ~bit;
+}
+
+void countLaneFishes(const struct TerritoryBatchEvaluator *evaluator, const struct GameGrid *gameGrid, const uint64_t *mask,
+                     int *fishes, int *numberOfTiles)
+{
+    const size_t boardSize = (size_t)evaluator->rows * evaluator->words;
+
+    for (int l = 0; l < BOARD_KERNEL_LANES; l++)
+        fishes[l] = numberOfTiles[l] = 0;
+
+    // the fish masks are shared by all the lanes, every word of them is loaded once
+    for (size_t w = 0; w < boardSize; w++)
+    {
+        const uint64_t one = gameGrid->fishMasks[1][w];
+        const uint64_t two = gameGrid->fishMasks[2][w];
+        const uint64_t three = gameGrid->fishMasks[3][w];
+
+        for (int l = 0; l < BOARD_KERNEL_LANES; l++)
+        {
+            const uint64_t lane = mask[w * BOARD_KERNEL_LANES + l];
+            numberOfTiles[l] += __builtin_popcountll(lane);
+            fishes[l] += __builtin_popcountll(lane & one) + 2 * __builtin_popcountll(lane & two) +
+                         3 * __builtin_popcountll(lane & three);
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef TERRITORY_BATCH_H
+#define TERRITORY_BATCH_H
+
+#include <stdint.h>
+#include "../GameGrid/Grid.h"
+#include "../GameGrid/GridPoint.h"
+#include "./Territory.h"
+
+// The territory evaluation of Territory.h for many positions at once. Every candidate differs from
+// the current board by a single placement or movement, so only the masks touched by it are stored
+// per candidate: they are laid out structure-of-arrays in BOARD_KERNEL_LANES lanes (see
+// GameGrid/BoardKernels.h) and the level-by-level expansion of all the lanes runs in the same loops,
+// while the fish masks are read from the grid once for all of them.
+
+// a position one action away from the current board: the penguin of playerId moves from -> to,
+// or is placed on `to` when from is NULL
+struct TerritoryCandidate
+{
+    const struct GridPoint *from;
+    const struct GridPoint *to;
+    int playerId;
+};
+
+// preallocated lane-interleaved masks for a board of given dimensions
+struct TerritoryBatchEvaluator
+{
+    int rows;
+    int cols;
+    int words;
+
+    uint64_t *through;   // tiles with fish of every lane
+    uint64_t *unclaimed; // tiles with fish not reached by anybody yet
+    uint64_t *frontiers; // (MAX_PLAYER_ID + 1) masks, tiles reached in the previous level
+    uint64_t *reached;   // (MAX_PLAYER_ID + 1) masks, tiles reached in the current level
+    uint64_t *seenOnce;  // tiles reached by at least one player in the current level
+    uint64_t *seenTwice; // tiles reached by at least two players in the current level
+};
+
+// allocates all the masks, it has to be done once the dimensions of the board are known
+struct TerritoryBatchEvaluator createTerritoryBatchEvaluatorObject(int rows, int cols);
+
+void freeTerritoryBatchEvaluatorObject(struct TerritoryBatchEvaluator *evaluator);
+
+// scores[i] is the territory of the board after candidates[i], exactly as evaluateTerritory
+// (Evaluation/TerritoryReference.h) would compute it, the grid itself is not modified
+void evaluateTerritoryBatch(struct TerritoryBatchEvaluator *evaluator, const struct GameGrid *gameGrid,
+                            const struct TerritoryCandidate *candidates, int numberOfCandidates, struct TerritoryScore *scores);
+
+#endif
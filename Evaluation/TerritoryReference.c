@@ -0,0 +1,134 @@
+#include "TerritoryReference.h"
+#include "stdlib.h"
+#include "string.h"
+#include "../GameGrid/BoardKernels.h"
+
+// =========================================
+// available public functions:
+
+struct TerritoryEvaluator createTerritoryEvaluatorObject(int rows, int cols);
+void freeTerritoryEvaluatorObject(struct TerritoryEvaluator *evaluator);
+void evaluateTerritory(struct TerritoryEvaluator *evaluator, const struct GameGrid *gameGrid, struct TerritoryScore *score);
+
+// private functions:
+
+int countFishes(const struct TerritoryEvaluator *evaluator, const struct GameGrid *gameGrid, const uint64_t *mask, int *numberOfTiles);
+
+// =========================================
+
+struct TerritoryEvaluator createTerritoryEvaluatorObject(int rows, int cols)
+{
+    struct TerritoryEvaluator obj;
+    obj.rows = rows;
+    obj.cols = cols;
+    obj.words = (cols + 63) / 64;
+
+    const size_t maskSize = (size_t)rows * obj.words;
+
+    obj.unclaimed = (uint64_t *)calloc(maskSize, sizeof(uint64_t));
+    obj.frontiers = (uint64_t *)calloc((MAX_PLAYER_ID + 1) * maskSize, sizeof(uint64_t));
+    obj.reached = (uint64_t *)calloc((MAX_PLAYER_ID + 1) * maskSize, sizeof(uint64_t));
+    obj.seenOnce = (uint64_t *)calloc(maskSize, sizeof(uint64_t));
+    obj.seenTwice = (uint64_t *)calloc(maskSize, sizeof(uint64_t));
+
+    return obj;
+}
+
+void freeTerritoryEvaluatorObject(struct TerritoryEvaluator *evaluator)
+{
+    free(evaluator->unclaimed);
+    free(evaluator->frontiers);
+    free(evaluator->reached);
+    free(evaluator->seenOnce);
+    free(evaluator->seenTwice);
+}
+
+void evaluateTerritory(struct TerritoryEvaluator *evaluator, const struct GameGrid *gameGrid, struct TerritoryScore *score)
+{
+    const int words = evaluator->words;
+    const size_t maskSize = (size_t)evaluator->rows * words;
+
+    memset(score, 0, sizeof(*score));
+
+    // the grid keeps its masks up to date, they only need to be copied
+    const uint64_t *freeTiles = gameGrid->fishMasks[0];
+    memcpy(evaluator->unclaimed, freeTiles, maskSize * sizeof(uint64_t));
+
+    bool anyFrontier = false;
+    for (int id = 0; id <= MAX_PLAYER_ID; id++)
+    {
+        memcpy(evaluator->frontiers + id * maskSize, gameGrid->penguinMasks[id], maskSize * sizeof(uint64_t));
+        anyFrontier |= gameGrid->numberOfPenguinsOf[id] > 0;
+    }
+
+    // every iteration is one more move for all of the players at once
+    while (anyFrontier)
+    {
+        memset(evaluator->seenOnce, 0, maskSize * sizeof(uint64_t));
+        memset(evaluator->seenTwice, 0, maskSize * sizeof(uint64_t));
+
+        for (int id = 0; id <= MAX_PLAYER_ID; id++)
+        {
+            if (!gameGrid->numberOfPenguinsOf[id])
+                continue;
+
+            // moves may pass over tiles claimed earlier, but only unclaimed tiles become new territory
+            uint64_t *reached = evaluator->reached + id * maskSize;
+            gameGrid->kernels->slideFromSources(evaluator->rows, evaluator->cols, words, evaluator->frontiers + id * maskSize, freeTiles, reached);
+
+            for (size_t w = 0; w < maskSize; w++)
+            {
+                reached[w] &= evaluator->unclaimed[w];
+                evaluator->seenTwice[w] |= evaluator->seenOnce[w] & reached[w];
+                evaluator->seenOnce[w] |= reached[w];
+            }
+        }
+
+        // tiles reached by two players in the same number of moves stay neutral and are not expanded further
+        anyFrontier = false;
+        for (int id = 0; id <= MAX_PLAYER_ID; id++)
+        {
+            if (!gameGrid->numberOfPenguinsOf[id])
+                continue;
+
+            uint64_t *frontier = evaluator->frontiers + id * maskSize;
+            const uint64_t *reached = evaluator->reached + id * maskSize;
+
+            uint64_t any = 0;
+            for (size_t w = 0; w < maskSize; w++)
+            {
+                frontier[w] = reached[w] & ~evaluator->seenTwice[w];
+                any |= frontier[w];
+            }
+
+            if (any)
+            {
+                int numberOfTiles;
+                score->fishes[id] += countFishes(evaluator, gameGrid, frontier, &numberOfTiles);
+                score->tiles[id] += numberOfTiles;
+                anyFrontier = true;
+            }
+        }
+
+        for (size_t w = 0; w < maskSize; w++)
+        {
+            evaluator->unclaimed[w] &= ~evaluator->seenOnce[w];
+        }
+    }
+}
+
+int countFishes(const struct TerritoryEvaluator *evaluator, const struct GameGrid *gameGrid, const uint64_t *mask, int *numberOfTiles)
+{
+    const size_t maskSize = (size_t)evaluator->rows * evaluator->words;
+
+    int fishes = 0;
+    *numberOfTiles = 0;
+    for (size_t w = 0; w < maskSize; w++)
+    {
+        *numberOfTiles += __builtin_popcountll(mask[w]);
+        fishes += __builtin_popcountll(mask[w] & gameGrid->fishMasks[1][w]);
+        fishes += 2 * __builtin_popcountll(mask[w] & gameGrid->fishMasks[2][w]);
+        fishes += 3 * __builtin_popcountll(mask[w] & gameGrid->fishMasks[3][w]);
+    }
+    return fishes;
+}
@@ -0,0 +1,32 @@
+#ifndef TERRITORY_REFERENCE_H
+#define TERRITORY_REFERENCE_H
+
+#include <stdint.h>
+#include "./Territory.h"
+
+// The territory of Territory.h evaluated for one position at a time, level by level, on the masks of the grid.
+// It is slow next to the batch evaluation and is not part of the engine, Tools/TerritoryCheck.c uses it
+// as the reference the batch scores are compared with.
+
+// preallocated bit masks for a board of given dimensions, laid out like the masks of GameGrid
+struct TerritoryEvaluator
+{
+    int rows;
+    int cols;
+    int words;
+
+    uint64_t *unclaimed;  // tiles with fish not reached by anybody yet
+    uint64_t *frontiers;  // (MAX_PLAYER_ID + 1) masks, tiles reached in the previous level
+    uint64_t *reached;    // (MAX_PLAYER_ID + 1) masks, tiles reached in the current level
+    uint64_t *seenOnce;   // tiles reached by at least one player in the current level
+    uint64_t *seenTwice;  // tiles reached by at least two players in the current level
+};
+
+// allocates all the masks, it has to be done once the dimensions of the board are known
+struct TerritoryEvaluator createTerritoryEvaluatorObject(int rows, int cols);
+
+void freeTerritoryEvaluatorObject(struct TerritoryEvaluator *evaluator);
+
+void evaluateTerritory(struct TerritoryEvaluator *evaluator, const struct GameGrid *gameGrid, struct TerritoryScore *score);
+
+#endif
@@ -0,0 +1,137 @@
+#include "GameCache.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+// =========================================
+// available public functions:
+
+enum ExceptionHandler loadGameCache(const char *outputFile, struct GameCache *cache);
+bool matchGameCache(const struct GameCache *cache, struct Player *myPlayer, struct GameGrid *gameGrid);
+enum ExceptionHandler saveGameCache(struct Player *myPlayer, struct GameGrid *gameGrid, uint32_t recordSize);
+void closeGameCache(struct GameCache *cache);
+
+// private functions:
+
+#define GAME_CACHE_HEADER_SIZE 16
+
+char *gameCachePath(const char *outputFile);
+bool hasCachedPlayer(const struct GameCache *cache, const struct Player *myPlayer);
+
+// =========================================
+
+enum ExceptionHandler loadGameCache(const char *outputFile, struct GameCache *cache)
+{
+    cache->data = NULL;
+
+    char *path = gameCachePath(outputFile);
+    FILE *file = fopen(path, "rb");
+    free(path);
+    if (file == NULL)
+        return (enum ExceptionHandler)FileOpenException;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    cache->data = size > GAME_CACHE_HEADER_SIZE ? (unsigned char *)malloc(size) : NULL;
+    if (cache->data == NULL || fread(cache->data, 1, size, file) != (size_t)size)
+    {
+        fclose(file);
+        closeGameCache(cache);
+        return (enum ExceptionHandler)FileFormatException;
+    }
+    fclose(file);
+
+    const unsigned char *data = cache->data;
+    if (memcmp(data, "PNGC", 4) || data[4] != GAME_CACHE_VERSION || readUint32(data + 12) != boardChecksum(data, 12))
+    {
+        closeGameCache(cache);
+        return (enum ExceptionHandler)FileFormatException;
+    }
+
+    cache->myPlayerId = data[5];
+    cache->recordSize = readUint32(data + 8);
+
+    // the board carries its own checksum
+    enum ExceptionHandler parseStatus = parseBinaryBoard(data + GAME_CACHE_HEADER_SIZE, (size_t)size - GAME_CACHE_HEADER_SIZE, &cache->board);
+    if (parseStatus != NoError)
+        closeGameCache(cache);
+
+    return parseStatus;
+}
+
+bool matchGameCache(const struct GameCache *cache, struct Player *myPlayer, struct GameGrid *gameGrid)
+{
+    if (cache->myPlayerId != myPlayer->id || !hasCachedPlayer(cache, myPlayer))
+        return false;
+
+    struct BinaryBoard current;
+    unsigned char *tiles = (unsigned char *)malloc((size_t)gameGrid->rows * gameGrid->cols);
+    packGridData(myPlayer, gameGrid, &current, tiles);
+
+    const bool continuation = isBoardContinuation(&cache->board, &current, myPlayer->id);
+    free(tiles);
+    return continuation;
+}
+
+enum ExceptionHandler saveGameCache(struct Player *myPlayer, struct GameGrid *gameGrid, uint32_t recordSize)
+{
+    struct BinaryBoard board;
+    unsigned char *tiles = (unsigned char *)malloc((size_t)gameGrid->rows * gameGrid->cols);
+    packGridData(myPlayer, gameGrid, &board, tiles);
+
+    size_t boardSize;
+    unsigned char *boardData = encodeBinaryBoard(&board, &boardSize);
+    free(tiles);
+    if (boardData == NULL)
+        return (enum ExceptionHandler)FileOpenException;
+
+    unsigned char header[GAME_CACHE_HEADER_SIZE];
+    memcpy(header, "PNGC", 4);
+    header[4] = GAME_CACHE_VERSION;
+    header[5] = (unsigned char)myPlayer->id;
+    writeUint16(header + 6, 0);
+    writeUint32(header + 8, recordSize);
+    writeUint32(header + 12, boardChecksum(header, 12));
+
+    char *path = gameCachePath(gameGrid->outputFile);
+    FILE *file = fopen(path, "wb");
+    free(path);
+    if (file == NULL)
+    {
+        free(boardData);
+        return (enum ExceptionHandler)FileOpenException;
+    }
+
+    const bool written = fwrite(header, 1, GAME_CACHE_HEADER_SIZE, file) == GAME_CACHE_HEADER_SIZE &&
+                         fwrite(boardData, 1, boardSize, file) == boardSize;
+    fclose(file);
+    free(boardData);
+
+    return written ? (enum ExceptionHandler)NoError : (enum ExceptionHandler)FileOpenException;
+}
+
+void closeGameCache(struct GameCache *cache)
+{
+    free(cache->data);
+    cache->data = NULL;
+}
+
+char *gameCachePath(const char *outputFile)
+{
+    const size_t length = strlen(outputFile) + strlen(GAME_CACHE_EXTENSION) + 1;
+    char *path = (char *)malloc(length);
+    snprintf(path, length, "%s%s", outputFile, GAME_CACHE_EXTENSION);
+    return path;
+}
+
+bool hasCachedPlayer(const struct GameCache *cache, const struct Player *myPlayer)
+{
+    for (int i = 0; i < cache->board.numberOfPlayers; i++)
+    {
+        if (cache->board.players[i].id == myPlayer->id && !strcmp(cache->board.players[i].name, myPlayer->name))
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,54 @@
+#ifndef GAME_CACHE_H
+#define GAME_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../GameGrid/Grid.h"
+#include "../GameGrid/BinaryBoard.h"
+#include "../Player/Player.h"
+#include "../Enums/ExceptionHandler.h"
+
+// Sidecar file written next to the output board (<outputFile>.cache) at the end of every turn by an
+// executable built with PENGUINS_WARM_START, so that the next invocation only has to look at what the
+// other players have changed since then:
+//
+//   0   "PNGC" magic
+//   4   u8  version (GAME_CACHE_VERSION)
+//   5   u8  our player id
+//   6   u16 reserved (0)
+//   8   u32 size of the game record (see GameRecord.h) right after our turn, GAME_CACHE_NO_RECORD if unknown
+//   12  u32 FNV-1a checksum of the bytes before it
+//   16  the board we wrote, in the binary board format (see BinaryBoard.h)
+//
+// The cache is just an optimisation of the game record (see GameRecord.h): when it still describes the last
+// recorded position, the record does not have to be replayed to append the changes of the other players.
+// When it is missing, damaged or belongs to another game, the record is replayed as before.
+// The grid itself is still built from the input board on every turn, only the record uses the cached board.
+
+#define GAME_CACHE_VERSION 1
+#define GAME_CACHE_EXTENSION ".cache"
+#define GAME_CACHE_NO_RECORD 0xFFFFFFFFu
+
+struct GameCache
+{
+    int myPlayerId;
+    uint32_t recordSize;
+
+    // the board we left at the end of our last turn, its tiles point into data
+    struct BinaryBoard board;
+    unsigned char *data;
+};
+
+// reads <outputFile>.cache into memory
+enum ExceptionHandler loadGameCache(const char *outputFile, struct GameCache *cache);
+
+// compares the cached board with the one just read, returns false if the cache does not belong
+// to this game and player (or the board just read cannot follow it, see isBoardContinuation)
+bool matchGameCache(const struct GameCache *cache, struct Player *myPlayer, struct GameGrid *gameGrid);
+
+// writes the cache of the current grid, has to be called once our action is made
+enum ExceptionHandler saveGameCache(struct Player *myPlayer, struct GameGrid *gameGrid, uint32_t recordSize);
+
+void closeGameCache(struct GameCache *cache);
+
+#endif
@@ -0,0 +1,531 @@
+#include "BinaryBoard.h"
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+
+#ifdef _WIN32
+// no mmap on windows, the file is simply read into memory
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define BINARY_BOARD_HEADER_SIZE 16
+#define BINARY_BOARD_PLAYER_SIZE 6 // id, name length and score, without the name itself
+
+// =========================================
+// available public functions:
+
+enum ExceptionHandler openBinaryBoard(const char *path, struct BinaryBoard *board);
+void closeBinaryBoard(struct BinaryBoard *board);
+enum ExceptionHandler parseBinaryBoard(const unsigned char *data, size_t size, struct BinaryBoard *board);
+enum ExceptionHandler writeBinaryBoard(const char *path, const struct BinaryBoard *board);
+unsigned char *encodeBinaryBoard(const struct BinaryBoard *board, size_t *size);
+bool binaryBoardFits(const struct BinaryBoard *board);
+enum ExceptionHandler readTextBoard(const char *path, struct BinaryBoard *board, unsigned char **tiles);
+enum ExceptionHandler parseTextBoard(const char *text, size_t size, struct BinaryBoard *board, unsigned char **tiles);
+char *encodeTextBoard(const struct BinaryBoard *board, size_t *size);
+enum ExceptionHandler convertTextBoardToBinary(const char *textPath, const char *binaryPath);
+enum ExceptionHandler convertBinaryBoardToText(const char *binaryPath, const char *textPath);
+enum ExceptionHandler writeTextBoard(const char *path, const struct BinaryBoard *board);
+void printTextBoard(FILE *file, const struct BinaryBoard *board);
+bool hasBinaryBoardExtension(const char *path);
+bool isBoardContinuation(const struct BinaryBoard *before, const struct BinaryBoard *after, int myPlayerId);
+uint32_t boardChecksum(const unsigned char *data, size_t size);
+unsigned readUint16(const unsigned char *at);
+uint32_t readUint32(const unsigned char *at);
+void writeUint16(unsigned char *at, unsigned value);
+void writeUint32(unsigned char *at, uint32_t value);
+
+// private functions:
+
+// the next whitespace separated word of the text, its length is 0 at the end of the text
+const char *nextTextToken(const char **at, const char *end, size_t *length);
+bool parseTextNumber(const char *token, size_t length, int *value);
+
+// a tile holds at most BINARY_BOARD_MAX_FISHES fish and belongs to nobody (0) or to a player up to MAX_PLAYER_ID
+bool isTileValid(int numberOfFishes, int ownerId);
+
+// =========================================
+
+bool hasBinaryBoardExtension(const char *path)
+{
+    const size_t suffixLength = strlen(BINARY_BOARD_EXTENSION);
+    const size_t pathLength = strlen(path);
+
+    return pathLength >= suffixLength && !strcmp(path + (pathLength - suffixLength), BINARY_BOARD_EXTENSION);
+}
+
+bool isBoardContinuation(const struct BinaryBoard *before, const struct BinaryBoard *after, int myPlayerId)
+{
+    if (before->rows != after->rows || before->cols != after->cols)
+        return false;
+
+    // arrivals and departures of every player, owner ids fit in a nibble
+    int arrivals[16] = {0};
+    int departures[16] = {0};
+
+    const size_t numberOfTiles = (size_t)before->rows * before->cols;
+    for (size_t i = 0; i < numberOfTiles; i++)
+    {
+        const unsigned char from = before->tiles[i];
+        const unsigned char to = after->tiles[i];
+        if (from == to)
+            continue;
+
+        // between our turns a tile can only lose its fish to a penguin of another player
+        // or lose the penguin standing on it, our own penguins stay where we left them
+        const bool hadFish = tileOwner(from) == 0 && tileFishes(from) > 0;
+        const bool hadPenguin = tileOwner(from) != 0 && (int)tileOwner(from) != myPlayerId;
+        if (hadFish && tileFishes(to) == 0 && tileOwner(to) != 0 && (int)tileOwner(to) != myPlayerId)
+            arrivals[tileOwner(to)]++;
+        else if (hadPenguin && to == packTile(0, 0))
+            departures[tileOwner(from)]++;
+        else
+            return false;
+    }
+
+    // a penguin cannot just disappear, every departure is a movement to one of the arrivals of the same player
+    // (the arrivals left over are placements)
+    for (int id = 0; id < 16; id++)
+    {
+        if (departures[id] > arrivals[id])
+            return false;
+    }
+
+    // the fish collected are never given back
+    for (int i = 0; i < before->numberOfPlayers; i++)
+    {
+        for (int j = 0; j < after->numberOfPlayers; j++)
+        {
+            if (before->players[i].id == after->players[j].id && after->players[j].collectedFishes < before->players[i].collectedFishes)
+                return false;
+        }
+    }
+    return true;
+}
+
+enum ExceptionHandler openBinaryBoard(const char *path, struct BinaryBoard *board)
+{
+    board->mapping = NULL;
+    board->mappingSize = 0;
+
+#ifdef _WIN32
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return (enum ExceptionHandler)FileOpenException;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    void *data = size > 0 ? malloc(size) : NULL;
+    if (data == NULL || fread(data, 1, size, file) != (size_t)size)
+    {
+        free(data);
+        fclose(file);
+        return (enum ExceptionHandler)FileFormatException;
+    }
+    fclose(file);
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return (enum ExceptionHandler)FileOpenException;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return (enum ExceptionHandler)FileFormatException;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after closing the descriptor
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return (enum ExceptionHandler)FileOpenException;
+#endif
+
+    board->mapping = data;
+    board->mappingSize = (size_t)size;
+
+    enum ExceptionHandler parseStatus = parseBinaryBoard((const unsigned char *)data, (size_t)size, board);
+    if (parseStatus != NoError)
+        closeBinaryBoard(board);
+
+    return parseStatus;
+}
+
+void closeBinaryBoard(struct BinaryBoard *board)
+{
+    if (board->mapping == NULL)
+        return;
+
+#ifdef _WIN32
+    free(board->mapping);
+#else
+    munmap(board->mapping, board->mappingSize);
+#endif
+
+    board->mapping = NULL;
+    board->mappingSize = 0;
+    board->tiles = NULL;
+}
+
+enum ExceptionHandler parseBinaryBoard(const unsigned char *data, size_t size, struct BinaryBoard *board)
+{
+    if (size < BINARY_BOARD_HEADER_SIZE + 4 || memcmp(data, "PNGB", 4) || data[4] != BINARY_BOARD_VERSION)
+        return (enum ExceptionHandler)FileFormatException;
+
+    if (readUint32(data + size - 4) != boardChecksum(data, size - 4))
+        return (enum ExceptionHandler)FileFormatException;
+
+    board->numberOfPlayers = data[5];
+    board->rows = readUint16(data + 6);
+    board->cols = readUint16(data + 8);
+
+    const size_t tilesOffset = readUint32(data + 12);
+    const size_t numberOfTiles = (size_t)board->rows * board->cols;
+    if (!binaryBoardFits(board) || board->numberOfPlayers > MAX_PLAYER_ID || tilesOffset + numberOfTiles + 4 != size)
+        return (enum ExceptionHandler)FileFormatException;
+
+    // player table
+    size_t offset = BINARY_BOARD_HEADER_SIZE;
+    for (int i = 0; i < board->numberOfPlayers; i++)
+    {
+        if (offset + BINARY_BOARD_PLAYER_SIZE > tilesOffset)
+            return (enum ExceptionHandler)FileFormatException;
+
+        struct BinaryBoardPlayer *player = &board->players[i];
+        player->id = data[offset];
+        const int nameLength = data[offset + 1];
+        player->collectedFishes = (int32_t)readUint32(data + offset + 2);
+        offset += BINARY_BOARD_PLAYER_SIZE;
+
+        if (offset + nameLength > tilesOffset)
+            return (enum ExceptionHandler)FileFormatException;
+
+        memcpy(player->name, data + offset, nameLength);
+        player->name[nameLength] = '\0';
+        offset += nameLength;
+    }
+
+    // the same tiles as the text format accepts
+    for (size_t i = 0; i < numberOfTiles; i++)
+    {
+        if (!isTileValid(tileFishes(data[tilesOffset + i]), tileOwner(data[tilesOffset + i])))
+            return (enum ExceptionHandler)FileFormatException;
+    }
+    board->tiles = data + tilesOffset;
+
+    return (enum ExceptionHandler)NoError;
+}
+
+enum ExceptionHandler writeBinaryBoard(const char *path, const struct BinaryBoard *board)
+{
+    // the whole file is composed in memory and written at once
+    if (!binaryBoardFits(board))
+        return (enum ExceptionHandler)FileFormatException;
+
+    size_t size;
+    unsigned char *data = encodeBinaryBoard(board, &size);
+    if (data == NULL)
+        return (enum ExceptionHandler)FileOpenException;
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        free(data);
+        return (enum ExceptionHandler)FileOpenException;
+    }
+
+    const size_t written = fwrite(data, 1, size, file);
+    fclose(file);
+    free(data);
+
+    return written == size ? (enum ExceptionHandler)NoError : (enum ExceptionHandler)FileOpenException;
+}
+
+bool binaryBoardFits(const struct BinaryBoard *board)
+{
+    return board->rows > 0 && board->rows <= BINARY_BOARD_MAX_SIDE && board->cols > 0 && board->cols <= BINARY_BOARD_MAX_SIDE;
+}
+
+unsigned char *encodeBinaryBoard(const struct BinaryBoard *board, size_t *size)
+{
+    *size = 0;
+    if (!binaryBoardFits(board))
+        return NULL;
+
+    *size = BINARY_BOARD_HEADER_SIZE;
+    for (int i = 0; i < board->numberOfPlayers; i++)
+    {
+        *size += BINARY_BOARD_PLAYER_SIZE + strnlen(board->players[i].name, BINARY_BOARD_MAX_NAME);
+    }
+    const size_t tilesOffset = *size;
+    const size_t numberOfTiles = (size_t)board->rows * board->cols;
+    *size += numberOfTiles + 4;
+
+    unsigned char *data = (unsigned char *)malloc(*size);
+    if (data == NULL)
+        return NULL;
+
+    memcpy(data, "PNGB", 4);
+    data[4] = BINARY_BOARD_VERSION;
+    data[5] = (unsigned char)board->numberOfPlayers;
+    writeUint16(data + 6, board->rows);
+    writeUint16(data + 8, board->cols);
+    writeUint16(data + 10, 0);
+    writeUint32(data + 12, (uint32_t)tilesOffset);
+
+    size_t offset = BINARY_BOARD_HEADER_SIZE;
+    for (int i = 0; i < board->numberOfPlayers; i++)
+    {
+        const struct BinaryBoardPlayer *player = &board->players[i];
+        const size_t nameLength = strnlen(player->name, BINARY_BOARD_MAX_NAME);
+
+        data[offset] = (unsigned char)player->id;
+        data[offset + 1] = (unsigned char)nameLength;
+        writeUint32(data + offset + 2, (uint32_t)player->collectedFishes);
+        memcpy(data + offset + BINARY_BOARD_PLAYER_SIZE, player->name, nameLength);
+        offset += BINARY_BOARD_PLAYER_SIZE + nameLength;
+    }
+
+    memcpy(data + tilesOffset, board->tiles, numberOfTiles);
+    writeUint32(data + *size - 4, boardChecksum(data, *size - 4));
+
+    return data;
+}
+
+enum ExceptionHandler readTextBoard(const char *path, struct BinaryBoard *board, unsigned char **tiles)
+{
+    *tiles = NULL;
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return (enum ExceptionHandler)FileOpenException;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *text = size > 0 ? (char *)malloc(size) : NULL;
+    if (text == NULL || fread(text, 1, size, file) != (size_t)size)
+    {
+        free(text);
+        fclose(file);
+        return (enum ExceptionHandler)FileFormatException;
+    }
+    fclose(file);
+
+    enum ExceptionHandler parseStatus = parseTextBoard(text, (size_t)size, board, tiles);
+    free(text);
+
+    return parseStatus;
+}
+
+enum ExceptionHandler parseTextBoard(const char *text, size_t size, struct BinaryBoard *board, unsigned char **tiles)
+{
+    *tiles = NULL;
+    board->mapping = NULL;
+    board->mappingSize = 0;
+
+    const char *at = text;
+    const char *end = text + size;
+    size_t length;
+    const char *token = nextTextToken(&at, end, &length);
+    if (!parseTextNumber(token, length, &board->rows))
+        return (enum ExceptionHandler)FileFormatException;
+    token = nextTextToken(&at, end, &length);
+    if (!parseTextNumber(token, length, &board->cols) || !binaryBoardFits(board))
+        return (enum ExceptionHandler)FileFormatException;
+
+    const size_t numberOfTiles = (size_t)board->rows * board->cols;
+    *tiles = (unsigned char *)malloc(numberOfTiles);
+    if (*tiles == NULL)
+        return (enum ExceptionHandler)FileFormatException;
+    for (size_t i = 0; i < numberOfTiles; i++)
+    {
+        token = nextTextToken(&at, end, &length);
+        if (length != 2 || token[0] < '0' || token[0] > '9' || token[1] < '0' || token[1] > '9' ||
+            !isTileValid(token[0] - '0', token[1] - '0'))
+        {
+            free(*tiles);
+            *tiles = NULL;
+            return (enum ExceptionHandler)FileFormatException;
+        }
+        (*tiles)[i] = packTile(token[0] - '0', token[1] - '0');
+    }
+    board->tiles = *tiles;
+
+    // the rest of the text contains the players: name id score
+    board->numberOfPlayers = 0;
+    while (board->numberOfPlayers < MAX_PLAYER_ID)
+    {
+        size_t nameLength, idLength, scoreLength;
+        const char *name = nextTextToken(&at, end, &nameLength);
+        const char *id = nextTextToken(&at, end, &idLength);
+        const char *score = nextTextToken(&at, end, &scoreLength);
+
+        struct BinaryBoardPlayer *player = &board->players[board->numberOfPlayers];
+        if (nameLength == 0 || !parseTextNumber(id, idLength, &player->id) || !parseTextNumber(score, scoreLength, &player->collectedFishes))
+            break;
+
+        nameLength = nameLength < BINARY_BOARD_MAX_NAME ? nameLength : BINARY_BOARD_MAX_NAME;
+        memcpy(player->name, name, nameLength);
+        player->name[nameLength] = '\0';
+        board->numberOfPlayers++;
+    }
+
+    return (enum ExceptionHandler)NoError;
+}
+
+const char *nextTextToken(const char **at, const char *end, size_t *length)
+{
+    while (*at < end && (**at == ' ' || **at == '\t' || **at == '\r' || **at == '\n'))
+        (*at)++;
+
+    const char *token = *at;
+    while (*at < end && **at != ' ' && **at != '\t' && **at != '\r' && **at != '\n')
+        (*at)++;
+
+    *length = *at - token;
+    return token;
+}
+
+bool parseTextNumber(const char *token, size_t length, int *value)
+{
+    char digits[16];
+    if (length == 0 || length >= sizeof(digits))
+        return false;
+
+    memcpy(digits, token, length);
+    digits[length] = '\0';
+
+    char *last;
+    *value = (int)strtol(digits, &last, 10);
+    return *last == '\0';
+}
+
+bool isTileValid(int numberOfFishes, int ownerId)
+{
+    return numberOfFishes >= 0 && numberOfFishes <= BINARY_BOARD_MAX_FISHES && ownerId >= 0 && ownerId <= MAX_PLAYER_ID;
+}
+
+enum ExceptionHandler convertTextBoardToBinary(const char *textPath, const char *binaryPath)
+{
+    struct BinaryBoard board;
+    unsigned char *tiles;
+    enum ExceptionHandler readStatus = readTextBoard(textPath, &board, &tiles);
+    if (readStatus != NoError)
+        return readStatus;
+
+    enum ExceptionHandler writeStatus = writeBinaryBoard(binaryPath, &board);
+    free(tiles);
+
+    return writeStatus;
+}
+
+enum ExceptionHandler convertBinaryBoardToText(const char *binaryPath, const char *textPath)
+{
+    struct BinaryBoard board;
+    enum ExceptionHandler openStatus = openBinaryBoard(binaryPath, &board);
+    if (openStatus != NoError)
+        return openStatus;
+
+    enum ExceptionHandler writeStatus = writeTextBoard(textPath, &board);
+    closeBinaryBoard(&board);
+
+    return writeStatus;
+}
+
+enum ExceptionHandler writeTextBoard(const char *path, const struct BinaryBoard *board)
+{
+    FILE *file = fopen(path, "w");
+    if (file == NULL)
+        return (enum ExceptionHandler)FileOpenException;
+
+    printTextBoard(file, board);
+
+    fclose(file);
+    return (enum ExceptionHandler)NoError;
+}
+
+void printTextBoard(FILE *file, const struct BinaryBoard *board)
+{
+    size_t size;
+    char *text = encodeTextBoard(board, &size);
+    if (text == NULL)
+        return;
+
+    fwrite(text, 1, size, file);
+    free(text);
+}
+
+char *encodeTextBoard(const struct BinaryBoard *board, size_t *size)
+{
+    // a tile takes at most 5 characters (both nibbles above 9), a player line at most its name and two numbers
+    const size_t capacity = 32 + (size_t)board->rows * (5 * board->cols + 1) + board->numberOfPlayers * (BINARY_BOARD_MAX_NAME + 32);
+    char *text = (char *)malloc(capacity);
+    if (text == NULL)
+        return NULL;
+
+    size_t length = snprintf(text, capacity, "%d %d\n", board->rows, board->cols);
+    for (int i = 0; i < board->rows; i++)
+    {
+        for (int j = 0; j < board->cols; j++)
+        {
+            const unsigned char tile = board->tiles[i * board->cols + j];
+            length += snprintf(text + length, capacity - length, "%d%d ", tileFishes(tile), tileOwner(tile));
+        }
+        text[length++] = '\n';
+    }
+    for (int i = 0; i < board->numberOfPlayers; i++)
+    {
+        length += snprintf(text + length, capacity - length, "%s %d %d\n", board->players[i].name, board->players[i].id,
+                           board->players[i].collectedFishes);
+    }
+
+    *size = length;
+    return text;
+}
+
+uint32_t boardChecksum(const unsigned char *data, size_t size)
+{
+    // 32 bit FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+unsigned readUint16(const unsigned char *at)
+{
+    return at[0] | (at[1] << 8);
+}
+
+uint32_t readUint32(const unsigned char *at)
+{
+    return (uint32_t)at[0] | ((uint32_t)at[1] << 8) | ((uint32_t)at[2] << 16) | ((uint32_t)at[3] << 24);
+}
+
+void writeUint16(unsigned char *at, unsigned value)
+{
+    at[0] = value & 0xFF;
+    at[1] = (value >> 8) & 0xFF;
+}
+
+void writeUint32(unsigned char *at, uint32_t value)
+{
+    at[0] = value & 0xFF;
+    at[1] = (value >> 8) & 0xFF;
+    at[2] = (value >> 16) & 0xFF;
+    at[3] = (value >> 24) & 0xFF;
+}
@@ -0,0 +1,110 @@
+#ifndef BINARY_BOARD_H
+#define BINARY_BOARD_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "./Grid.h"
+#include "../Enums/ExceptionHandler.h"
+
+// Binary board layout (all numbers little-endian):
+//
+//   0   "PNGB" magic
+//   4   u8  version (BINARY_BOARD_VERSION)
+//   5   u8  number of players
+//   6   u16 rows
+//   8   u16 cols
+//   10  u16 reserved (0)
+//   12  u32 offset of the tiles section
+//   16  player table, for every player: u8 id, u8 name length, i32 collected fish, name bytes
+//   ..  tiles, rows * cols bytes in row order, each one packed with packTile
+//   ..  u32 FNV-1a checksum of every byte before it
+
+#define BINARY_BOARD_VERSION 1
+#define BINARY_BOARD_EXTENSION ".bin"
+#define BINARY_BOARD_MAX_NAME 255
+#define BINARY_BOARD_MAX_SIDE 65535 // rows and cols are stored as u16
+#define BINARY_BOARD_MAX_FISHES 3
+
+// a single tile is stored in one byte: number of fish in the low nibble, owner id in the high one
+#define packTile(fishes, ownerId) ((unsigned char)(((fishes) & 0x0F) | (((ownerId) & 0x0F) << 4)))
+#define tileFishes(tile) ((tile) & 0x0F)
+#define tileOwner(tile) ((tile) >> 4)
+
+struct BinaryBoardPlayer
+{
+    int id;
+    int collectedFishes;
+    char name[BINARY_BOARD_MAX_NAME + 1];
+};
+
+struct BinaryBoard
+{
+    int rows;
+    int cols;
+
+    int numberOfPlayers;
+    struct BinaryBoardPlayer players[MAX_PLAYER_ID];
+
+    // rows * cols packed tiles, when the board is opened from a file this points
+    // straight into the mapped file so nothing is copied
+    const unsigned char *tiles;
+
+    // memory backing the board when it was opened with openBinaryBoard
+    void *mapping;
+    size_t mappingSize;
+};
+
+// maps the file into memory and validates the header and the checksum
+enum ExceptionHandler openBinaryBoard(const char *path, struct BinaryBoard *board);
+
+// releases the memory mapped by openBinaryBoard
+void closeBinaryBoard(struct BinaryBoard *board);
+
+// parses a board which is already in memory, tiles will point into data
+enum ExceptionHandler parseBinaryBoard(const unsigned char *data, size_t size, struct BinaryBoard *board);
+
+enum ExceptionHandler writeBinaryBoard(const char *path, const struct BinaryBoard *board);
+
+// the whole binary image of the board in a buffer allocated with malloc, NULL if out of memory
+// or if the board does not fit the format (see binaryBoardFits)
+unsigned char *encodeBinaryBoard(const struct BinaryBoard *board, size_t *size);
+
+// whether the dimensions of the board can be stored in the binary header
+bool binaryBoardFits(const struct BinaryBoard *board);
+
+// reads a board in the two-digit text format in a single pass, tiles are allocated with malloc
+// and have to be freed by the caller
+enum ExceptionHandler readTextBoard(const char *path, struct BinaryBoard *board, unsigned char **tiles);
+
+// the same for a text which is already in memory, it does not have to be null-terminated
+enum ExceptionHandler parseTextBoard(const char *text, size_t size, struct BinaryBoard *board, unsigned char **tiles);
+
+// the board in the two-digit text format in a buffer allocated with malloc (not null-terminated), NULL if out of memory
+char *encodeTextBoard(const struct BinaryBoard *board, size_t *size);
+
+// writes the board in the two-digit text format
+enum ExceptionHandler writeTextBoard(const char *path, const struct BinaryBoard *board);
+void printTextBoard(FILE *file, const struct BinaryBoard *board);
+
+// converters between the binary format and the two-digit text format
+enum ExceptionHandler convertTextBoardToBinary(const char *textPath, const char *binaryPath);
+enum ExceptionHandler convertBinaryBoardToText(const char *binaryPath, const char *textPath);
+
+bool hasBinaryBoardExtension(const char *path);
+
+// whether after can follow before once the other players have played, i.e. the boards have the same size,
+// fish were only taken by penguins of the other players, our penguins (myPlayerId) stayed where they were,
+// every penguin that left its tile moved to another one and no score went down
+bool isBoardContinuation(const struct BinaryBoard *before, const struct BinaryBoard *after, int myPlayerId);
+
+uint32_t boardChecksum(const unsigned char *data, size_t size);
+
+// little-endian helpers shared with the other binary formats
+unsigned readUint16(const unsigned char *at);
+uint32_t readUint32(const unsigned char *at);
+void writeUint16(unsigned char *at, unsigned value);
+void writeUint32(unsigned char *at, uint32_t value);
+
+#endif
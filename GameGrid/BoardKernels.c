@@ -0,0 +1,302 @@
+#include "BoardKernels.h"
+#include "stddef.h"
+
+// =========================================
+// available public functions:
+
+const struct BoardKernels *selectBoardKernels(int cols);
+
+// private functions:
+
+// column j of a row is bit j % 64 of word j / 64, east means towards the more significant bits
+void shiftRowEast(const uint64_t *row, uint64_t *result, int shift, int words);
+void shiftRowWest(const uint64_t *row, uint64_t *result, int shift, int words);
+void shiftLanesEast(const BoardLanes *row, BoardLanes *result, int shift, int words);
+void shiftLanesWest(const BoardLanes *row, BoardLanes *result, int shift, int words);
+uint64_t lowBits(int count);
+
+// =========================================
+
+// Body of every kernel set. WORDS and COLS are either compile-time constants of the width class
+// or the runtime `words` and `cols` parameters for the generic set.
+#define DEFINE_BOARD_KERNELS(SUFFIX, WORDS, COLS)                                                                         \
+    void slideFromSources##SUFFIX(int rows, int cols, int words, const uint64_t *sources, const uint64_t *through,        \
+                                  uint64_t *reachable)                                                                    \
+    {                                                                                                                     \
+        (void)cols;                                                                                                       \
+        (void)words;                                                                                                      \
+        uint64_t east[WORDS], west[WORDS], propagateEast[WORDS], propagateWest[WORDS], scratch[WORDS];                    \
+                                                                                                                          \
+        /* horizontal moves: Kogge-Stone fill, after the step with shift s every tile knows about sources */              \
+        /* up to 2s tiles away, with a constant COLS the steps are fully unrolled */                                      \
+        for (int r = 0; r < rows; r++)                                                                                    \
+        {                                                                                                                 \
+            const uint64_t *rowSources = sources + r * (WORDS);                                                           \
+            const uint64_t *rowThrough = through + r * (WORDS);                                                           \
+            for (int w = 0; w < (WORDS); w++)                                                                             \
+            {                                                                                                             \
+                east[w] = west[w] = rowSources[w];                                                                        \
+                propagateEast[w] = propagateWest[w] = rowThrough[w];                                                      \
+            }                                                                                                             \
+                                                                                                                          \
+            for (int shift = 1; shift < (COLS); shift *= 2)                                                               \
+            {                                                                                                             \
+                shiftRowEast(east, scratch, shift, (WORDS));                                                              \
+                for (int w = 0; w < (WORDS); w++)                                                                         \
+                    east[w] |= propagateEast[w] & scratch[w];                                                             \
+                shiftRowEast(propagateEast, scratch, shift, (WORDS));                                                     \
+                for (int w = 0; w < (WORDS); w++)                                                                         \
+                    propagateEast[w] &= scratch[w];                                                                       \
+                                                                                                                          \
+                shiftRowWest(west, scratch, shift, (WORDS));                                                              \
+                for (int w = 0; w < (WORDS); w++)                                                                         \
+                    west[w] |= propagateWest[w] & scratch[w];                                                             \
+                shiftRowWest(propagateWest, scratch, shift, (WORDS));                                                     \
+                for (int w = 0; w < (WORDS); w++)                                                                         \
+                    propagateWest[w] &= scratch[w];                                                                       \
+            }                                                                                                             \
+                                                                                                                          \
+            for (int w = 0; w < (WORDS); w++)                                                                             \
+                reachable[r * (WORDS) + w] = (east[w] | west[w]) & rowThrough[w];                                         \
+        }                                                                                                                 \
+                                                                                                                          \
+        /* vertical moves, the run of every column is carried from one row to the next */                                 \
+        for (int w = 0; w < (WORDS); w++)                                                                                 \
+        {                                                                                                                 \
+            uint64_t down = 0;                                                                                            \
+            for (int r = 1; r < rows; r++)                                                                                \
+            {                                                                                                             \
+                down = (down | sources[(r - 1) * (WORDS) + w]) & through[r * (WORDS) + w];                                \
+                reachable[r * (WORDS) + w] |= down;                                                                       \
+            }                                                                                                             \
+                                                                                                                          \
+            uint64_t up = 0;                                                                                              \
+            for (int r = rows - 2; r >= 0; r--)                                                                           \
+            {                                                                                                             \
+                up = (up | sources[(r + 1) * (WORDS) + w]) & through[r * (WORDS) + w];                                    \
+                reachable[r * (WORDS) + w] |= up;                                                                         \
+            }                                                                                                             \
+        }                                                                                                                 \
+    }                                                                                                                     \
+                                                                                                                          \
+    void slideFromSourcesLanes##SUFFIX(int rows, int cols, int words, const uint64_t *sources, const uint64_t *through,   \
+                                       uint64_t *reachable)                                                               \
+    {                                                                                                                     \
+        (void)cols;                                                                                                       \
+        (void)words;                                                                                                      \
+        const BoardLanes *laneSources = (const BoardLanes *)sources;                                                      \
+        const BoardLanes *laneThrough = (const BoardLanes *)through;                                                      \
+        BoardLanes *laneReachable = (BoardLanes *)reachable;                                                              \
+        BoardLanes east[WORDS], west[WORDS], propagateEast[WORDS], propagateWest[WORDS], scratch[WORDS];                  \
+                                                                                                                          \
+        /* the same steps as slideFromSources, every operation covers all the lanes */                                    \
+        for (int r = 0; r < rows; r++)                                                                                    \
+        {                                                                                                                 \
+            const BoardLanes *rowSources = laneSources + r * (WORDS);                                                     \
+            const BoardLanes *rowThrough = laneThrough + r * (WORDS);                                                     \
+            for (int w = 0; w < (WORDS); w++)                                                                             \
+            {                                                                                                             \
+                east[w] = west[w] = rowSources[w];                                                                        \
+                propagateEast[w] = propagateWest[w] = rowThrough[w];                                                      \
+            }                                                                                                             \
+                                                                                                                          \
+            for (int shift = 1; shift < (COLS); shift *= 2)                                                               \
+            {                                                                                                             \
+                shiftLanesEast(east, scratch, shift, (WORDS));                                                            \
+                for (int w = 0; w < (WORDS); w++)                                                                         \
+                    east[w] |= propagateEast[w] & scratch[w];                                                             \
+                shiftLanesEast(propagateEast, scratch, shift, (WORDS));                                                   \
+                for (int w = 0; w < (WORDS); w++)                                                                         \
+                    propagateEast[w] &= scratch[w];                                                                       \
+                                                                                                                          \
+                shiftLanesWest(west, scratch, shift, (WORDS));                                                            \
+                for (int w = 0; w < (WORDS); w++)                                                                         \
+                    west[w] |= propagateWest[w] & scratch[w];                                                             \
+                shiftLanesWest(propagateWest, scratch, shift, (WORDS));                                                   \
+                for (int w = 0; w < (WORDS); w++)                                                                         \
+                    propagateWest[w] &= scratch[w];                                                                       \
+            }                                                                                                             \
+                                                                                                                          \
+            for (int w = 0; w < (WORDS); w++)                                                                             \
+                laneReachable[r * (WORDS) + w] = (east[w] | west[w]) & rowThrough[w];                                     \
+        }                                                                                                                 \
+                                                                                                                          \
+        for (int w = 0; w < (WORDS); w++)                                                                                 \
+        {                                                                                                                 \
+            BoardLanes down = {0};                                                                                        \
+            for (int r = 1; r < rows; r++)                                                                                \
+            {                                                                                                             \
+                down = (down | laneSources[(r - 1) * (WORDS) + w]) & laneThrough[r * (WORDS) + w];                        \
+                laneReachable[r * (WORDS) + w] |= down;                                                                   \
+            }                                                                                                             \
+                                                                                                                          \
+            BoardLanes up = {0};                                                                                          \
+            for (int r = rows - 2; r >= 0; r--)                                                                           \
+            {                                                                                                             \
+                up = (up | laneSources[(r + 1) * (WORDS) + w]) & laneThrough[r * (WORDS) + w];                            \
+                laneReachable[r * (WORDS) + w] |= up;                                                                     \
+            }                                                                                                             \
+        }                                                                                                                 \
+    }                                                                                                                     \
+                                                                                                                          \
+    int findInRow##SUFFIX(const uint64_t *throughA, const uint64_t *throughB, const uint64_t *target, int cols,           \
+                          int words, int y, int direction)                                                                \
+    {                                                                                                                     \
+        (void)cols;                                                                                                       \
+        (void)words;                                                                                                      \
+        /* one word at a time: the traversable run starting next to the penguin is measured with a */                     \
+        /* single count of trailing (or leading) ones, bits past the last column are never set */                         \
+        if (direction > 0)                                                                                                \
+        {                                                                                                                 \
+            for (int j = y + 1; j < (WORDS) * 64;)                                                                        \
+            {                                                                                                             \
+                const int w = j / 64, b = j % 64;                                                                         \
+                const uint64_t run = ~((throughA[w] | throughB[w]) >> b);                                                 \
+                const int length = run ? __builtin_ctzll(run) : 64;                                                       \
+                const uint64_t found = (target[w] >> b) & lowBits(length);                                                \
+                if (found)                                                                                                \
+                    return j + __builtin_ctzll(found);                                                                    \
+                if (length < 64 - b)                                                                                      \
+                    return -1;                                                                                            \
+                j += 64 - b;                                                                                              \
+            }                                                                                                             \
+        }                                                                                                                 \
+        else                                                                                                              \
+        {                                                                                                                 \
+            for (int j = y - 1; j >= 0;)                                                                                  \
+            {                                                                                                             \
+                const int w = j / 64, b = j % 64;                                                                         \
+                const uint64_t run = ~((throughA[w] | throughB[w]) << (63 - b));                                          \
+                const int length = run ? __builtin_clzll(run) : 64;                                                       \
+                const uint64_t found = (target[w] << (63 - b)) & ~lowBits(64 - length);                                   \
+                if (found)                                                                                                \
+                    return j - __builtin_clzll(found);                                                                    \
+                if (length < b + 1)                                                                                       \
+                    return -1;                                                                                            \
+                j -= b + 1;                                                                                               \
+            }                                                                                                             \
+        }                                                                                                                 \
+        return -1;                                                                                                        \
+    }                                                                                                                     \
+                                                                                                                          \
+    int findAdjacentPair##SUFFIX(const uint64_t *a, const uint64_t *b, int rows, int cols, int words, int direction)      \
+    {                                                                                                                     \
+        (void)words;                                                                                                      \
+        uint64_t neighbours[WORDS];                                                                                       \
+        for (int r = 0; r < rows; r++)                                                                                    \
+        {                                                                                                                 \
+            /* bring the neighbour of every tile onto the tile itself */                                                  \
+            if (direction > 0)                                                                                            \
+                shiftRowWest(b + r * (WORDS), neighbours, 1, (WORDS));                                                    \
+            else                                                                                                          \
+                shiftRowEast(b + r * (WORDS), neighbours, 1, (WORDS));                                                    \
+                                                                                                                          \
+            for (int w = 0; w < (WORDS); w++)                                                                             \
+            {                                                                                                             \
+                const uint64_t found = a[r * (WORDS) + w] & neighbours[w];                                                \
+                if (found)                                                                                                \
+                    return r * cols + w * 64 + __builtin_ctzll(found);                                                    \
+            }                                                                                                             \
+        }                                                                                                                 \
+        return -1;                                                                                                        \
+    }
+
+DEFINE_BOARD_KERNELS(32, 1, 32)
+DEFINE_BOARD_KERNELS(64, 1, 64)
+DEFINE_BOARD_KERNELS(128, 2, 128)
+DEFINE_BOARD_KERNELS(Generic, words, cols)
+
+#define BOARD_KERNELS_ENTRY(SUFFIX, MAX_COLS) \
+    {#SUFFIX, MAX_COLS, &slideFromSources##SUFFIX, &slideFromSourcesLanes##SUFFIX, &findInRow##SUFFIX, \
+     &findAdjacentPair##SUFFIX}
+
+const struct BoardKernels *selectBoardKernels(int cols)
+{
+    // read-only table, widest class last
+    static const struct BoardKernels kernels[] = {
+        BOARD_KERNELS_ENTRY(32, 32),
+        BOARD_KERNELS_ENTRY(64, 64),
+        BOARD_KERNELS_ENTRY(128, 128),
+        BOARD_KERNELS_ENTRY(Generic, 0),
+    };
+
+    for (size_t i = 0; i + 1 < sizeof(kernels) / sizeof(kernels[0]); i++)
+    {
+        if (cols <= kernels[i].maxCols)
+            return &kernels[i];
+    }
+    return &kernels[sizeof(kernels) / sizeof(kernels[0]) - 1];
+}
+
+void shiftRowEast(const uint64_t *row, uint64_t *result, int shift, int words)
+{
+    const int wordShift = shift / 64;
+    const int bitShift = shift % 64;
+
+    for (int w = words - 1; w >= 0; w--)
+    {
+        const int from = w - wordShift;
+        uint64_t value = 0;
+        if (from >= 0)
+            value = row[from] << bitShift;
+        if (bitShift && from - 1 >= 0)
+            value |= row[from - 1] >> (64 - bitShift);
+        result[w] = value;
+    }
+}
+
+void shiftRowWest(const uint64_t *row, uint64_t *result, int shift, int words)
+{
+    const int wordShift = shift / 64;
+    const int bitShift = shift % 64;
+
+    for (int w = 0; w < words; w++)
+    {
+        const int from = w + wordShift;
+        uint64_t value = 0;
+        if (from < words)
+            value = row[from] >> bitShift;
+        if (bitShift && from + 1 < words)
+            value |= row[from + 1] << (64 - bitShift);
+        result[w] = value;
+    }
+}
+
+void shiftLanesEast(const BoardLanes *row, BoardLanes *result, int shift, int words)
+{
+    const int wordShift = shift / 64;
+    const int bitShift = shift % 64;
+
+    for (int w = words - 1; w >= 0; w--)
+    {
+        const int from = w - wordShift;
+        BoardLanes value = {0};
+        if (from >= 0)
+            value = row[from] << bitShift;
+        if (bitShift && from - 1 >= 0)
+            value |= row[from - 1] >> (64 - bitShift);
+        result[w] = value;
+    }
+}
+
+void shiftLanesWest(const BoardLanes *row, BoardLanes *result, int shift, int words)
+{
+    const int wordShift = shift / 64;
+    const int bitShift = shift % 64;
+
+    for (int w = 0; w < words; w++)
+    {
+        const int from = w + wordShift;
+        BoardLanes value = {0};
+        if (from < words)
+            value = row[from] >> bitShift;
+        if (bitShift && from + 1 < words)
+            value |= row[from + 1] << (64 - bitShift);
+        result[w] = value;
+    }
+}
+
+uint64_t lowBits(int count)
+{
+    return count >= 64 ? ~(uint64_t)0 : ((uint64_t)1 << count) - 1;
+}
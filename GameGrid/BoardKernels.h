@@ -0,0 +1,42 @@
+#ifndef BOARD_KERNELS_H
+#define BOARD_KERNELS_H
+
+#include <stdint.h>
+
+// Hot loops working on the bit masks of the board (see GameGrid). They are instantiated for every
+// common width class with the number of words per row and the number of fill steps known at compile
+// time, so the compiler can unroll and vectorise them. The set is picked once per board by
+// selectBoardKernels, boards wider than the largest class use the generic instantiation.
+
+// number of boards processed side by side by the lane kernels, their masks are interleaved so that
+// word w of lane l is stored at w * BOARD_KERNEL_LANES + l and one operation covers the same word of all lanes
+#define BOARD_KERNEL_LANES 8
+
+// the same word of all the lanes as a single value, GCC lowers every operation on it to the widest vector
+// instructions of the target (the masks are not required to be aligned for it)
+typedef uint64_t BoardLanes __attribute__((vector_size(8 * BOARD_KERNEL_LANES), aligned(8)));
+
+struct BoardKernels
+{
+    const char *name;
+    int maxCols; // widest board handled by the set, 0 for the generic one
+
+    // every tile reachable with a single straight move from any of the sources through tiles marked in `through`
+    void (*slideFromSources)(int rows, int cols, int words, const uint64_t *sources, const uint64_t *through, uint64_t *reachable);
+
+    // the same for BOARD_KERNEL_LANES boards at once, all the masks are lane-interleaved
+    void (*slideFromSourcesLanes)(int rows, int cols, int words, const uint64_t *sources, const uint64_t *through, uint64_t *reachable);
+
+    // walking along a row from column y in the direction (1 - east, -1 - west) through tiles marked in
+    // throughA or throughB, returns the column of the first tile marked in target or -1 if a blocker comes first
+    // (columns are scanned with the same kernel over the transposed masks, see GameGrid)
+    int (*findInRow)(const uint64_t *throughA, const uint64_t *throughB, const uint64_t *target, int cols, int words, int y, int direction);
+
+    // first tile (row by row) marked in a whose neighbour in the direction (1 - east, -1 - west) is marked in b,
+    // returns its index x * cols + y or -1
+    int (*findAdjacentPair)(const uint64_t *a, const uint64_t *b, int rows, int cols, int words, int direction);
+};
+
+const struct BoardKernels *selectBoardKernels(int cols);
+
+#endif
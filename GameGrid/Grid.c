@@ -1,4 +1,6 @@
 #include "Grid.h"
+#include "BinaryBoard.h"
+#include "BoardKernels.h"
 #include "stdlib.h"
 #include "stdio.h"
 #include "string.h"
@@ -6,6 +8,7 @@
 #include "time.h"
 #include "../Player/Player.h"
 #include "../Enums/ExceptionHandler.h"
+#include "../GameSystem/GameLog.h"
 
 // =========================================
 // available public functions:
@@ -13,11 +16,25 @@
 struct GameGrid createGameGridObject();
 enum ExceptionHandler readGridData(struct Player *myPlayer, struct GameGrid *gameGrid);
 enum ExceptionHandler writeGridData(struct Player *myPlayer, struct GameGrid *gameGrid);
+void updateTile(struct GameGrid *gameGrid, struct GridPoint *point, int numberOfFishes, struct Player *owner);
+void packGridData(struct Player *myPlayer, struct GameGrid *gameGrid, struct BinaryBoard *board, unsigned char *tiles);
+enum ExceptionHandler loadGridData(struct Player *myPlayer, struct GameGrid *gameGrid, const unsigned char *data, size_t size);
+unsigned char *encodeGridData(struct Player *myPlayer, struct GameGrid *gameGrid, bool binary, size_t *size);
+void freeGameGridObject(struct GameGrid *gameGrid);
 
 // private functions:
 
 void initializeGrid(struct GameGrid *gameGrid);
-enum ExceptionHandler initializeMyPlayer(const struct GameGrid *gameGrid, struct Player *player);
+void addPenguinToList(struct GameGrid *gameGrid, int playerId, struct GridPoint *point);
+void removePenguinFromList(struct GameGrid *gameGrid, int playerId, struct GridPoint *point);
+void setMaskBit(uint64_t *mask, int words, const struct GridPoint *point, bool value);
+void setColumnMaskBit(uint64_t *mask, int words, const struct GridPoint *point, bool value);
+bool registerPlayer(const struct GameGrid *gameGrid, struct Player *player, const char *playerName, int playerId, int playerPoints);
+void finishPlayersRegistration(const struct GameGrid *gameGrid, struct Player *player, bool found, int lastPlayerId);
+void setTileFromFile(struct GameGrid *gameGrid, struct Player *myPlayer, struct GridPoint *p, int numberOfFishes, int ownerId);
+enum ExceptionHandler readBinaryGridData(struct Player *myPlayer, struct GameGrid *gameGrid);
+void loadGridFromBoard(struct Player *myPlayer, struct GameGrid *gameGrid, const struct BinaryBoard *board);
+enum ExceptionHandler writeBinaryGridData(struct Player *myPlayer, struct GameGrid *gameGrid);
 
 // =========================================
 
@@ -31,11 +48,36 @@ struct GameGrid createGameGridObject()
     obj.inputFile = malloc(100 * sizeof(char));
     obj.outputFile = malloc(100 * sizeof(char));
 
+    obj.rows = 0;
+    obj.cols = 0;
+    obj.grid = NULL;
+
+    for (int i = 0; i <= MAX_PLAYER_ID; i++)
+    {
+        obj.penguins[i] = NULL;
+        obj.numberOfPenguinsOf[i] = 0;
+        obj.penguinsCapacityOf[i] = 0;
+        obj.penguinMasks[i] = NULL;
+        obj.penguinColumnMasks[i] = NULL;
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        obj.fishMasks[i] = NULL;
+        obj.fishColumnMasks[i] = NULL;
+    }
+    obj.maskWords = 0;
+    obj.kernels = NULL;
+    obj.columnWords = 0;
+    obj.columnKernels = NULL;
+
     return obj;
 }
 
 enum ExceptionHandler writeGridData(struct Player *myPlayer, struct GameGrid *gameGrid)
 {
+    if (hasBinaryBoardExtension(gameGrid->outputFile))
+        return writeBinaryGridData(myPlayer, gameGrid);
+
     FILE *file = fopen(gameGrid->outputFile, "w");
     if (file == NULL)
         return (enum ExceptionHandler)FileOpenException;
@@ -59,18 +101,14 @@ enum ExceptionHandler writeGridData(struct Player *myPlayer, struct GameGrid *ga
     {
         if (i + 1 == myPlayer->id)
         {
-            char buffer[100];
-            sprintf(buffer, "%s %d %d", myPlayer->name, myPlayer->id, myPlayer->collectedFishes);
-            printf("\nbuffer: %s", buffer);
-            fprintf(file, buffer);
-            fprintf(file, "\n");
+            gameLog("\nbuffer: %s %d %d", myPlayer->name, myPlayer->id, myPlayer->collectedFishes);
+            fprintf(file, "%s %d %d\n", myPlayer->name, myPlayer->id, myPlayer->collectedFishes);
         }
         else
         {
-            printf("\nplayer: %s", gameGrid->gameInstance->fullPlayersData[i]);
+            gameLog("\nplayer: %s", gameGrid->gameInstance->fullPlayersData[i]);
 
-            fprintf(file, gameGrid->gameInstance->fullPlayersData[i]);
-            fprintf(file, "\n");
+            fprintf(file, "%s\n", gameGrid->gameInstance->fullPlayersData[i]);
         }
     }
 
@@ -80,126 +118,253 @@ enum ExceptionHandler writeGridData(struct Player *myPlayer, struct GameGrid *ga
 
 enum ExceptionHandler readGridData(struct Player *myPlayer, struct GameGrid *gameGrid)
 {
+    if (hasBinaryBoardExtension(gameGrid->inputFile))
+        return readBinaryGridData(myPlayer, gameGrid);
 
-    enum ExceptionHandler playerInitResult = initializeMyPlayer(gameGrid, myPlayer);
-    if (playerInitResult != NoError)
-        return playerInitResult;
+    // the text file is read once, players included, and then loaded the same way as a binary board
+    struct BinaryBoard board;
+    unsigned char *tiles;
+    enum ExceptionHandler readStatus = readTextBoard(gameGrid->inputFile, &board, &tiles);
+    if (readStatus != NoError)
+        return readStatus;
 
-    FILE *inputFile = fopen(gameGrid->inputFile, "r");
-    if (inputFile == NULL)
-        return (enum ExceptionHandler)FileOpenException;
+    loadGridFromBoard(myPlayer, gameGrid, &board);
+
+    free(tiles);
+    return (enum ExceptionHandler)NoError;
+}
 
-    // read grid dimensions
-    fscanf(inputFile, "%d %d", &gameGrid->rows, &gameGrid->cols);
+bool registerPlayer(const struct GameGrid *gameGrid, struct Player *player, const char *playerName, int playerId, int playerPoints)
+{
+    // the formatted line: playerName playerId playerScore, names are at most BINARY_BOARD_MAX_NAME long so it always fits
+    snprintf(gameGrid->gameInstance->fullPlayersData[gameGrid->gameInstance->numberOfPlayers], MAX_PLAYER_DATA_LENGTH, "%s %d %d",
+             playerName, playerId, playerPoints);
 
-    // allocate memory for grid points
-    initializeGrid(gameGrid);
+    gameGrid->gameInstance->numberOfPlayers++;
 
-    // read grid content
-    for (int i = 0; i < gameGrid->rows; i++)
+    // our player nickname found
+    if (!strcmp(player->name, playerName))
     {
-        for (int j = 0; j < gameGrid->cols; j++)
+        player->id = playerId;
+        player->collectedFishes = playerPoints;
+        return true;
+    }
+    return false;
+}
+
+void finishPlayersRegistration(const struct GameGrid *gameGrid, struct Player *player, bool found, int lastPlayerId)
+{
+    if (!found)
+    {
+        player->id = !gameGrid->gameInstance->numberOfPlayers ? 1 : lastPlayerId + 1; // lastPlayerId holds the id of the last player written in the file
+
+        // a full table has no line left for us
+        if (gameGrid->gameInstance->numberOfPlayers < gameGrid->gameInstance->maxNumberOfPlayers)
         {
-            char *field = malloc(2 * sizeof(char));
-            fscanf(inputFile, "%s", field);
+            snprintf(gameGrid->gameInstance->fullPlayersData[gameGrid->gameInstance->numberOfPlayers], MAX_PLAYER_DATA_LENGTH, "%s %d %d",
+                     player->name, player->id, player->collectedFishes);
+            gameGrid->gameInstance->numberOfPlayers++;
+        }
+    }
 
-            struct GridPoint *p = &gameGrid->grid[i][j];
+    for (int i = 0; i < gameGrid->gameInstance->numberOfPlayers; i++)
+    {
+        gameLog("\nPlayer %d: %s\n", i + 1, gameGrid->gameInstance->fullPlayersData[i]);
+    }
+
+    gameLog("\nour player name, id and points: %s %d %d", player->name, player->id, player->collectedFishes);
+}
+
+void setTileFromFile(struct GameGrid *gameGrid, struct Player *myPlayer, struct GridPoint *p, int numberOfFishes, int ownerId)
+{
+    struct Player *owner;
 
-            (*p).x = i;
-            (*p).y = j;
-            // we do not care about the owner, we just need to know
-            // that the tile belongs to somebody and so the pointer cannot be null :)
-            if (field[1] - '0' == myPlayer->id)
-            {
-                (*p).owner = myPlayer;
-                gameGrid->gameInstance->numberOfPlacedPenguins++;
-            }
-            else
-            {
-                struct Player tempPlayer = createPlayerObject();
-                tempPlayer.id = field[1] - '0';
-                if (tempPlayer.id == 0)
-                {
-                    (*p).owner = NULL;
-                }
-                else
-                {
-                    (*p).owner = (struct Player *)malloc(sizeof(struct Player));
-                    *((*p).owner) = tempPlayer;
-                }
-            }
-
-            (*p).numberOfFishes = field[0] - '0';
+    // we do not care about the owner, we just need to know
+    // that the tile belongs to somebody and so the pointer cannot be null :)
+    if (ownerId == myPlayer->id)
+    {
+        owner = myPlayer;
+        gameGrid->gameInstance->numberOfPlacedPenguins++;
+    }
+    else
+    {
+        struct Player tempPlayer = createPlayerObject();
+        tempPlayer.id = ownerId;
+        if (tempPlayer.id == 0)
+        {
+            owner = NULL;
+        }
+        else
+        {
+            owner = (struct Player *)malloc(sizeof(struct Player));
+            *owner = tempPlayer;
         }
     }
 
-    fclose(inputFile);
-    return (enum ExceptionHandler)NoError;
+    updateTile(gameGrid, p, numberOfFishes, owner);
 }
 
-enum ExceptionHandler initializeMyPlayer(const struct GameGrid *gameGrid, struct Player *player)
+enum ExceptionHandler readBinaryGridData(struct Player *myPlayer, struct GameGrid *gameGrid)
 {
-    FILE *file = fopen(gameGrid->inputFile, "r");
-    if (file == NULL)
-        return (enum ExceptionHandler)FileOpenException;
+    struct BinaryBoard board;
+    enum ExceptionHandler openStatus = openBinaryBoard(gameGrid->inputFile, &board);
+    if (openStatus != NoError)
+        return openStatus;
 
-    char buffer[1000];
+    // tiles are read straight from the mapped file
+    loadGridFromBoard(myPlayer, gameGrid, &board);
 
-    // rows + 1 cause of the first line being the dimensions of the grid
-    char *field = malloc(50 * sizeof(char));
+    closeBinaryBoard(&board);
+    return (enum ExceptionHandler)NoError;
+}
 
-    int rows, cols;
-    // read grid dimensions
-    fscanf(file, "%d %d", &rows, &cols);
+void loadGridFromBoard(struct Player *myPlayer, struct GameGrid *gameGrid, const struct BinaryBoard *board)
+{
+    // players go first, the tiles need to know our id
+    bool found = false;
+    int lastPlayerId = 0;
+    for (int i = 0; i < board->numberOfPlayers; i++)
+    {
+        found |= registerPlayer(gameGrid, myPlayer, board->players[i].name, board->players[i].id, board->players[i].collectedFishes);
+        lastPlayerId = board->players[i].id;
+    }
+    finishPlayersRegistration(gameGrid, myPlayer, found, lastPlayerId);
 
-    // skip reading the lines containing grid data
-    for (int i = 0; i < rows; i++)
+    gameGrid->rows = board->rows;
+    gameGrid->cols = board->cols;
+    initializeGrid(gameGrid);
+
+    const unsigned char *tile = board->tiles;
+    for (int i = 0; i < gameGrid->rows; i++)
     {
-        for (int j = 0; j < cols; j++)
+        for (int j = 0; j < gameGrid->cols; j++, tile++)
         {
-            fscanf(file, "%s", field);
+            setTileFromFile(gameGrid, myPlayer, &gameGrid->grid[i][j], tileFishes(*tile), tileOwner(*tile));
         }
     }
+}
 
-    char *playerName = malloc(100 * sizeof(char));
-    int playerId = 0;
-    int playerPoints;
+enum ExceptionHandler loadGridData(struct Player *myPlayer, struct GameGrid *gameGrid, const unsigned char *data, size_t size)
+{
+    // the binary format is recognised by its magic, anything else has to be a text board
+    struct BinaryBoard board;
+    if (size >= 4 && !memcmp(data, "PNGB", 4))
+    {
+        enum ExceptionHandler parseStatus = parseBinaryBoard(data, size, &board);
+        if (parseStatus != NoError)
+            return parseStatus;
 
-    bool found = false;
+        loadGridFromBoard(myPlayer, gameGrid, &board);
+        return (enum ExceptionHandler)NoError;
+    }
 
-    // loop through data related to players
-    while (fscanf(file, "%s %d %d", playerName, &playerId, &playerPoints) == 3)
-    {
-        char buffer[100];
-        sprintf(buffer, "%s %d %d", playerName, playerId, playerPoints); // buffer with the formatted string: playerName playerId playerScore
-        strcpy(gameGrid->gameInstance->fullPlayersData[gameGrid->gameInstance->numberOfPlayers], buffer);
+    unsigned char *tiles;
+    enum ExceptionHandler parseStatus = parseTextBoard((const char *)data, size, &board, &tiles);
+    if (parseStatus != NoError)
+        return parseStatus;
 
-        gameGrid->gameInstance->numberOfPlayers++;
+    loadGridFromBoard(myPlayer, gameGrid, &board);
 
-        // our player nickname found
-        if (!strcmp(player->name, playerName))
+    free(tiles);
+    return (enum ExceptionHandler)NoError;
+}
+
+unsigned char *encodeGridData(struct Player *myPlayer, struct GameGrid *gameGrid, bool binary, size_t *size)
+{
+    struct BinaryBoard board;
+    unsigned char *tiles = (unsigned char *)malloc((size_t)gameGrid->rows * gameGrid->cols);
+    packGridData(myPlayer, gameGrid, &board, tiles);
+
+    unsigned char *data = binary ? encodeBinaryBoard(&board, size) : (unsigned char *)encodeTextBoard(&board, size);
+    free(tiles);
+
+    return data;
+}
+
+void freeGameGridObject(struct GameGrid *gameGrid)
+{
+    for (int i = 0; i < gameGrid->rows && gameGrid->grid != NULL; i++)
+    {
+        // every penguin of the other players got its own owner when the board was loaded
+        for (int j = 0; j < gameGrid->cols; j++)
         {
-            found = true;
-            player->id = playerId;
-            player->collectedFishes = playerPoints;
+            struct Player *owner = gameGrid->grid[i][j].owner;
+            if (owner != NULL && owner != &gameGrid->gameInstance->myPlayer)
+                free(owner);
         }
+        free(gameGrid->grid[i]);
     }
-    if (!found)
+    free(gameGrid->grid);
+    gameGrid->grid = NULL;
+
+    for (int i = 0; i <= MAX_PLAYER_ID; i++)
+    {
+        free(gameGrid->penguins[i]);
+        free(gameGrid->penguinMasks[i]);
+        free(gameGrid->penguinColumnMasks[i]);
+        gameGrid->penguins[i] = NULL;
+        gameGrid->penguinMasks[i] = NULL;
+        gameGrid->penguinColumnMasks[i] = NULL;
+    }
+    for (int i = 0; i < 4; i++)
     {
-        player->id = !gameGrid->gameInstance->numberOfPlayers ? 1 : playerId + 1; // playerId will hold the id of the last player written in the file
-        gameGrid->gameInstance->numberOfPlayers++;
+        free(gameGrid->fishMasks[i]);
+        free(gameGrid->fishColumnMasks[i]);
+        gameGrid->fishMasks[i] = NULL;
+        gameGrid->fishColumnMasks[i] = NULL;
     }
+}
 
-    for (int i = 0; i < gameGrid->gameInstance->numberOfPlayers; i++)
+void packGridData(struct Player *myPlayer, struct GameGrid *gameGrid, struct BinaryBoard *board, unsigned char *tiles)
+{
+    board->rows = gameGrid->rows;
+    board->cols = gameGrid->cols;
+
+    for (int i = 0; i < gameGrid->rows; i++)
+    {
+        for (int j = 0; j < gameGrid->cols; j++)
+        {
+            const struct GridPoint *t = &gameGrid->grid[i][j];
+            tiles[i * gameGrid->cols + j] = packTile(t->numberOfFishes, t->owner ? t->owner->id : 0);
+        }
+    }
+    board->tiles = tiles;
+
+    // same player table as in the text format, our own entry gets the updated score
+    board->numberOfPlayers = 0;
+    for (int i = 0; i < gameGrid->gameInstance->numberOfPlayers && i < MAX_PLAYER_ID; i++)
     {
-        printf("\nPlayer %d: %s\n", i + 1, gameGrid->gameInstance->fullPlayersData[i]);
+        struct BinaryBoardPlayer *player = &board->players[board->numberOfPlayers];
+        if (i + 1 == myPlayer->id)
+        {
+            strncpy(player->name, myPlayer->name, BINARY_BOARD_MAX_NAME);
+            player->name[BINARY_BOARD_MAX_NAME] = '\0';
+            player->id = myPlayer->id;
+            player->collectedFishes = myPlayer->collectedFishes;
+        }
+        else
+        {
+            // the width is BINARY_BOARD_MAX_NAME, the names were already cut to it when the board was parsed
+            if (sscanf(gameGrid->gameInstance->fullPlayersData[i], "%255s %d %d", player->name, &player->id, &player->collectedFishes) != 3)
+                continue;
+        }
+        board->numberOfPlayers++;
     }
 
-    printf("\nour player name, id and points: %s %d %d", player->name, player->id, player->collectedFishes);
+    board->mapping = NULL;
+    board->mappingSize = 0;
+}
 
-    fclose(file);
+enum ExceptionHandler writeBinaryGridData(struct Player *myPlayer, struct GameGrid *gameGrid)
+{
+    struct BinaryBoard board;
+    unsigned char *tiles = (unsigned char *)malloc((size_t)gameGrid->rows * gameGrid->cols);
+    packGridData(myPlayer, gameGrid, &board, tiles);
 
-    return (enum ExceptionHandler)NoError;
+    enum ExceptionHandler writeStatus = writeBinaryBoard(gameGrid->outputFile, &board);
+    free(tiles);
+
+    return writeStatus;
 }
 
 void initializeGrid(struct GameGrid *gameGrid)
@@ -213,5 +378,107 @@ void initializeGrid(struct GameGrid *gameGrid)
     for (int i = 0; i < rows; i++)
     {
         gameGrid->grid[i] = (struct GridPoint *)malloc(cols * sizeof(struct GridPoint));
+
+        // every tile starts as an empty one, the actual content is set through updateTile
+        for (int j = 0; j < cols; j++)
+        {
+            struct GridPoint *p = &gameGrid->grid[i][j];
+            p->x = i;
+            p->y = j;
+            p->numberOfFishes = 0;
+            p->owner = NULL;
+            p->penguinIndex = -1;
+        }
+    }
+
+    gameGrid->maskWords = (cols + 63) / 64;
+    gameGrid->columnWords = (rows + 63) / 64;
+    for (int i = 0; i < 4; i++)
+    {
+        gameGrid->fishMasks[i] = (uint64_t *)calloc(rows * gameGrid->maskWords, sizeof(uint64_t));
+        gameGrid->fishColumnMasks[i] = (uint64_t *)calloc(cols * gameGrid->columnWords, sizeof(uint64_t));
+    }
+    for (int i = 0; i <= MAX_PLAYER_ID; i++)
+    {
+        gameGrid->penguinMasks[i] = (uint64_t *)calloc(rows * gameGrid->maskWords, sizeof(uint64_t));
+        gameGrid->penguinColumnMasks[i] = (uint64_t *)calloc(cols * gameGrid->columnWords, sizeof(uint64_t));
+    }
+
+    gameGrid->kernels = selectBoardKernels(cols);
+    gameGrid->columnKernels = selectBoardKernels(rows);
+}
+
+void updateTile(struct GameGrid *gameGrid, struct GridPoint *point, int numberOfFishes, struct Player *owner)
+{
+    if (point->owner != owner)
+    {
+        if (point->owner != NULL)
+            removePenguinFromList(gameGrid, point->owner->id, point);
+        if (owner != NULL)
+            addPenguinToList(gameGrid, owner->id, point);
+    }
+
+    // the row masks and their column mirror always change together
+    const int words = gameGrid->maskWords;
+    const int columnWords = gameGrid->columnWords;
+    for (int i = 0; i <= 3; i++)
+    {
+        const bool value = i == 0 ? numberOfFishes > 0 : numberOfFishes == i;
+        setMaskBit(gameGrid->fishMasks[i], words, point, value);
+        setColumnMaskBit(gameGrid->fishColumnMasks[i], columnWords, point, value);
+    }
+    if (point->owner != NULL && point->owner->id >= 0 && point->owner->id <= MAX_PLAYER_ID)
+    {
+        setMaskBit(gameGrid->penguinMasks[point->owner->id], words, point, false);
+        setColumnMaskBit(gameGrid->penguinColumnMasks[point->owner->id], columnWords, point, false);
+    }
+    if (owner != NULL && owner->id >= 0 && owner->id <= MAX_PLAYER_ID)
+    {
+        setMaskBit(gameGrid->penguinMasks[owner->id], words, point, true);
+        setColumnMaskBit(gameGrid->penguinColumnMasks[owner->id], columnWords, point, true);
+    }
+
+    point->numberOfFishes = numberOfFishes;
+    point->owner = owner;
+}
+
+void setMaskBit(uint64_t *mask, int words, const struct GridPoint *point, bool value)
+{
+    const uint64_t bit = (uint64_t)1 << (point->y % 64);
+    uint64_t *word = &mask[point->x * words + point->y / 64];
+    *word = value ? *word | bit : *word & ~bit;
+}
+
+void setColumnMaskBit(uint64_t *mask, int words, const struct GridPoint *point, bool value)
+{
+    const uint64_t bit = (uint64_t)1 << (point->x % 64);
+    uint64_t *word = &mask[point->y * words + point->x / 64];
+    *word = value ? *word | bit : *word & ~bit;
+}
+
+void addPenguinToList(struct GameGrid *gameGrid, int playerId, struct GridPoint *point)
+{
+    if (playerId < 0 || playerId > MAX_PLAYER_ID)
+        return;
+
+    if (gameGrid->numberOfPenguinsOf[playerId] == gameGrid->penguinsCapacityOf[playerId])
+    {
+        int capacity = gameGrid->penguinsCapacityOf[playerId] ? 2 * gameGrid->penguinsCapacityOf[playerId] : 8;
+        gameGrid->penguins[playerId] = (struct GridPoint **)realloc(gameGrid->penguins[playerId], capacity * sizeof(struct GridPoint *));
+        gameGrid->penguinsCapacityOf[playerId] = capacity;
     }
+
+    point->penguinIndex = gameGrid->numberOfPenguinsOf[playerId];
+    gameGrid->penguins[playerId][gameGrid->numberOfPenguinsOf[playerId]++] = point;
+}
+
+void removePenguinFromList(struct GameGrid *gameGrid, int playerId, struct GridPoint *point)
+{
+    if (playerId < 0 || playerId > MAX_PLAYER_ID || point->penguinIndex < 0)
+        return;
+
+    struct GridPoint *last = gameGrid->penguins[playerId][--gameGrid->numberOfPenguinsOf[playerId]];
+    gameGrid->penguins[playerId][point->penguinIndex] = last;
+    last->penguinIndex = point->penguinIndex;
+    point->penguinIndex = -1;
 }
\ No newline at end of file
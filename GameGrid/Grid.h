@@ -1,17 +1,48 @@
 #ifndef GRID_H
 #define GRID_H
 
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include "./GridPoint.h"
 #include "../Enums/GameState.h"
 #include "../Enums/ExceptionHandler.h"
 #include "../GameSystem/GameSystem.h"
 
+struct BinaryBoard;
+struct BoardKernels;
+
+// player ids are stored as a single digit in the board file
+#define MAX_PLAYER_ID 9
+
 struct GameGrid
 {
     int rows;
     int cols;
     struct GridPoint **grid;
 
+    // tiles occupied by penguins of every player, indexed by the player id
+    struct GridPoint **penguins[MAX_PLAYER_ID + 1];
+    int numberOfPenguinsOf[MAX_PLAYER_ID + 1];
+    int penguinsCapacityOf[MAX_PLAYER_ID + 1];
+
+    // the same content as bit masks, every row takes maskWords 64 bit words and column j is bit j % 64
+    // of word j / 64; fishMasks[0] marks every tile with fish, fishMasks[1..3] tiles with exactly that many
+    int maskWords;
+    uint64_t *fishMasks[4];
+    uint64_t *penguinMasks[MAX_PLAYER_ID + 1];
+
+    // loops over the masks specialised for the width of this board, picked once the dimensions are known
+    const struct BoardKernels *kernels;
+
+    // transposed mirror of the masks above: every column takes columnWords words and row i is bit i % 64
+    // of word i / 64, so a vertical scan reads one contiguous column with the row kernels of columnKernels
+    // (picked for the height of the board) instead of jumping between the rows
+    int columnWords;
+    uint64_t *fishColumnMasks[4];
+    uint64_t *penguinColumnMasks[MAX_PLAYER_ID + 1];
+    const struct BoardKernels *columnKernels;
+
     enum ExceptionHandler (*readGridData)(struct Player *myPlayer, struct GameGrid *gameGrid);
     enum ExceptionHandler (*writeGridData)(struct Player *myPlayer, struct GameGrid *gameGrid);
 
@@ -23,4 +54,20 @@ struct GameGrid
 
 struct GameGrid createGameGridObject();
 
+// changes the content of a single tile and keeps the penguins lists and the masks in sync,
+// every modification of the grid after it has been read should go through this function
+void updateTile(struct GameGrid *gameGrid, struct GridPoint *point, int numberOfFishes, struct Player *owner);
+
+// packs the current grid and the players table into a binary board, tiles must hold rows * cols bytes
+void packGridData(struct Player *myPlayer, struct GameGrid *gameGrid, struct BinaryBoard *board, unsigned char *tiles);
+
+// loads the grid from a board which is already in memory, either in the binary format or in the text one
+enum ExceptionHandler loadGridData(struct Player *myPlayer, struct GameGrid *gameGrid, const unsigned char *data, size_t size);
+
+// the current grid in the binary or in the text format, in a buffer allocated with malloc
+unsigned char *encodeGridData(struct Player *myPlayer, struct GameGrid *gameGrid, bool binary, size_t *size);
+
+// releases everything allocated for the grid once it was read, the file names belong to the caller
+void freeGameGridObject(struct GameGrid *gameGrid);
+
 #endif
\ No newline at end of file
@@ -10,6 +10,10 @@ struct GridPoint
     int numberOfFishes;
 
     struct Player *owner;
+
+    // position inside GameGrid's penguins list of the owner (-1 if not listed),
+    // it allows removing the tile from that list in constant time
+    int penguinIndex;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,494 @@
+#include "GameRecord.h"
+#include "stdlib.h"
+#include "stdio.h"
+#include "string.h"
+#include "../GameSystem/GameSystem.h"
+
+#define GAME_RECORD_HEADER_SIZE 10
+
+// =========================================
+// available public functions:
+
+enum ExceptionHandler openGameRecord(const char *path, struct GameRecordReader *reader);
+bool readNextGameRecordFrame(struct GameRecordReader *reader);
+void closeGameRecord(struct GameRecordReader *reader);
+enum ExceptionHandler beginGameRecordTurn(struct Player *myPlayer, struct GameGrid *gameGrid, const struct BinaryBoard *lastPosition);
+enum ExceptionHandler appendGameRecordAction(struct GameGrid *gameGrid, enum GameRecordFrameType type, int playerId,
+                                             struct GridPoint **changedTiles, int numberOfChangedTiles, int scoreDelta);
+long gameRecordSize(const struct GameGrid *gameGrid);
+
+// private functions:
+
+char *gameRecordPath(const struct GameGrid *gameGrid);
+enum ExceptionHandler startGameRecord(const char *path, const struct BinaryBoard *board);
+enum ExceptionHandler rotateGameRecord(const char *path);
+enum ExceptionHandler appendGameRecordBytes(const char *path, const char *mode, const unsigned char *bytes, size_t size);
+size_t encodeKeyframe(unsigned char *at, const struct BinaryBoard *board);
+bool havePlayersChanged(const struct BinaryBoard *recorded, const struct BinaryBoard *current);
+struct BinaryBoardPlayer *findRecordedPlayer(struct BinaryBoard *board, int id);
+size_t writeVarint(unsigned char *at, uint32_t value);
+bool readVarint(struct GameRecordReader *reader, uint32_t *value);
+bool readKeyframe(struct GameRecordReader *reader);
+bool readDeltaFrame(struct GameRecordReader *reader);
+
+// =========================================
+
+enum ExceptionHandler openGameRecord(const char *path, struct GameRecordReader *reader)
+{
+    reader->data = NULL;
+    reader->tiles = NULL;
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return (enum ExceptionHandler)FileOpenException;
+
+    // the whole record is read at once, replaying it is then a single sequential pass over memory
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    reader->data = size > 0 ? (unsigned char *)malloc(size) : NULL;
+    if (reader->data == NULL || fread(reader->data, 1, size, file) != (size_t)size)
+    {
+        fclose(file);
+        closeGameRecord(reader);
+        return (enum ExceptionHandler)FileFormatException;
+    }
+    fclose(file);
+
+    reader->size = (size_t)size;
+    if (reader->size < GAME_RECORD_HEADER_SIZE || memcmp(reader->data, "PNGR", 4) || reader->data[4] != GAME_RECORD_VERSION)
+    {
+        closeGameRecord(reader);
+        return (enum ExceptionHandler)FileFormatException;
+    }
+
+    reader->position.rows = readUint16(reader->data + 6);
+    reader->position.cols = readUint16(reader->data + 8);
+    reader->position.numberOfPlayers = 0;
+    reader->position.mapping = NULL;
+    reader->position.mappingSize = 0;
+
+    reader->tiles = (unsigned char *)calloc((size_t)reader->position.rows * reader->position.cols, 1);
+    reader->position.tiles = reader->tiles;
+
+    reader->offset = GAME_RECORD_HEADER_SIZE;
+    reader->ply = -1;
+
+    // every record starts with a keyframe
+    if (!readNextGameRecordFrame(reader) || reader->lastFrameType != GameRecordKeyframe)
+    {
+        closeGameRecord(reader);
+        return (enum ExceptionHandler)FileFormatException;
+    }
+
+    return (enum ExceptionHandler)NoError;
+}
+
+void closeGameRecord(struct GameRecordReader *reader)
+{
+    free(reader->data);
+    free(reader->tiles);
+    reader->data = NULL;
+    reader->tiles = NULL;
+}
+
+bool readNextGameRecordFrame(struct GameRecordReader *reader)
+{
+    if (reader->offset >= reader->size)
+        return false;
+
+    const size_t frameStart = reader->offset;
+    const enum GameRecordFrameType type = (enum GameRecordFrameType)reader->data[reader->offset++];
+
+    bool read;
+    switch (type)
+    {
+    case GameRecordKeyframe:
+    {
+        read = readKeyframe(reader);
+        break;
+    }
+    case GameRecordExternalChanges:
+    case GameRecordPlacement:
+    case GameRecordMovement:
+    {
+        read = readDeltaFrame(reader);
+        break;
+    }
+    default:
+    {
+        read = false;
+    }
+    }
+
+    if (!read)
+    {
+        // a damaged frame ends the record, offset is left at the end of the last valid one
+        reader->offset = frameStart;
+        return false;
+    }
+
+    reader->lastFrameType = type;
+    reader->ply++;
+    return true;
+}
+
+bool readKeyframe(struct GameRecordReader *reader)
+{
+    const unsigned char *data = reader->data;
+    size_t offset = reader->offset;
+
+    if (offset + 1 > reader->size || data[offset] > MAX_PLAYER_ID)
+        return false;
+
+    struct BinaryBoard *position = &reader->position;
+    const int numberOfPlayers = data[offset++];
+    for (int i = 0; i < numberOfPlayers; i++)
+    {
+        if (offset + 6 > reader->size || offset + 6 + data[offset + 1] > reader->size)
+            return false;
+
+        struct BinaryBoardPlayer *player = &position->players[i];
+        player->id = data[offset];
+        const int nameLength = data[offset + 1];
+        player->collectedFishes = (int32_t)readUint32(data + offset + 2);
+        memcpy(player->name, data + offset + 6, nameLength);
+        player->name[nameLength] = '\0';
+        offset += 6 + nameLength;
+    }
+
+    const size_t numberOfTiles = (size_t)position->rows * position->cols;
+    if (offset + numberOfTiles > reader->size)
+        return false;
+
+    position->numberOfPlayers = numberOfPlayers;
+    memcpy(reader->tiles, data + offset, numberOfTiles);
+    reader->offset = offset + numberOfTiles;
+    reader->lastPlayerId = 0;
+
+    return true;
+}
+
+bool readDeltaFrame(struct GameRecordReader *reader)
+{
+    if (reader->offset + 1 > reader->size)
+        return false;
+
+    const int playerId = reader->data[reader->offset++];
+    const uint32_t numberOfTiles = (uint32_t)reader->position.rows * reader->position.cols;
+
+    uint32_t numberOfChangedTiles;
+    if (!readVarint(reader, &numberOfChangedTiles))
+        return false;
+
+    for (uint32_t i = 0; i < numberOfChangedTiles; i++)
+    {
+        uint32_t index;
+        if (!readVarint(reader, &index) || index >= numberOfTiles || reader->offset + 1 > reader->size)
+            return false;
+        reader->tiles[index] = reader->data[reader->offset++];
+    }
+
+    if (reader->offset + 1 > reader->size)
+        return false;
+
+    const int numberOfScoreChanges = reader->data[reader->offset++];
+    for (int i = 0; i < numberOfScoreChanges; i++)
+    {
+        if (reader->offset + 1 > reader->size)
+            return false;
+
+        const int id = reader->data[reader->offset++];
+        uint32_t zigzag;
+        if (!readVarint(reader, &zigzag))
+            return false;
+
+        struct BinaryBoardPlayer *player = findRecordedPlayer(&reader->position, id);
+        if (player != NULL)
+            player->collectedFishes += (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+    }
+
+    reader->lastPlayerId = playerId;
+    return true;
+}
+
+enum ExceptionHandler beginGameRecordTurn(struct Player *myPlayer, struct GameGrid *gameGrid, const struct BinaryBoard *lastPosition)
+{
+    char *path = gameRecordPath(gameGrid);
+    const size_t numberOfTiles = (size_t)gameGrid->rows * gameGrid->cols;
+
+    struct BinaryBoard current;
+    unsigned char *tiles = (unsigned char *)malloc(numberOfTiles);
+    packGridData(myPlayer, gameGrid, &current, tiles);
+
+    struct GameRecordReader reader;
+    reader.data = NULL;
+    reader.tiles = NULL;
+    enum ExceptionHandler status;
+    bool damaged = false;
+
+    // without the last position at hand the whole record has to be replayed to get it
+    if (lastPosition == NULL)
+    {
+        const enum ExceptionHandler openStatus = openGameRecord(path, &reader);
+        if (openStatus != NoError)
+        {
+            // a file which is not a record at all is kept aside as well
+            status = openStatus == FileOpenException ? (enum ExceptionHandler)NoError : rotateGameRecord(path);
+            if (status == NoError)
+                status = startGameRecord(path, &current);
+            free(tiles);
+            free(path);
+            return status;
+        }
+
+        while (readNextGameRecordFrame(&reader))
+            ;
+        damaged = reader.offset != reader.size;
+        lastPosition = &reader.position;
+    }
+
+    const struct BinaryBoard *recorded = lastPosition;
+    if (damaged || recorded->rows != current.rows || recorded->cols != current.cols)
+    {
+        // nothing can be appended after a damaged frame and the dimensions are fixed by the header,
+        // the old record is moved aside and a new one is started
+        status = rotateGameRecord(path);
+        if (status == NoError)
+            status = startGameRecord(path, &current);
+    }
+    else if (!isBoardContinuation(recorded, &current, myPlayer->id) || havePlayersChanged(recorded, &current))
+    {
+        // a board which cannot follow the recorded one (a new game of the same size) or new players,
+        // the record goes on from a keyframe of the board itself
+        unsigned char *frame = (unsigned char *)malloc(2 + MAX_PLAYER_ID * (6 + BINARY_BOARD_MAX_NAME) + numberOfTiles);
+        const size_t frameSize = encodeKeyframe(frame, &current);
+        status = appendGameRecordBytes(path, "ab", frame, frameSize);
+        free(frame);
+    }
+    else
+    {
+        // only the tiles and scores that differ from the last recorded position are stored
+        unsigned char *frame = (unsigned char *)malloc(8 + numberOfTiles * 6 + MAX_PLAYER_ID * 6);
+        size_t frameSize = 0;
+        frame[frameSize++] = GameRecordExternalChanges;
+        frame[frameSize++] = 0;
+
+        uint32_t numberOfChangedTiles = 0;
+        for (size_t i = 0; i < numberOfTiles; i++)
+        {
+            numberOfChangedTiles += recorded->tiles[i] != current.tiles[i];
+        }
+        frameSize += writeVarint(frame + frameSize, numberOfChangedTiles);
+        for (size_t i = 0; i < numberOfTiles; i++)
+        {
+            if (recorded->tiles[i] == current.tiles[i])
+                continue;
+            frameSize += writeVarint(frame + frameSize, (uint32_t)i);
+            frame[frameSize++] = current.tiles[i];
+        }
+
+        const size_t scoreCountAt = frameSize++;
+        int numberOfScoreChanges = 0;
+        for (int i = 0; i < current.numberOfPlayers; i++)
+        {
+            const int32_t delta = current.players[i].collectedFishes - recorded->players[i].collectedFishes;
+            if (delta == 0)
+                continue;
+            frame[frameSize++] = (unsigned char)current.players[i].id;
+            frameSize += writeVarint(frame + frameSize, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+            numberOfScoreChanges++;
+        }
+        frame[scoreCountAt] = (unsigned char)numberOfScoreChanges;
+
+        status = numberOfChangedTiles || numberOfScoreChanges ? appendGameRecordBytes(path, "ab", frame, frameSize)
+                                                              : (enum ExceptionHandler)NoError;
+        free(frame);
+    }
+
+    closeGameRecord(&reader);
+    free(tiles);
+    free(path);
+    return status;
+}
+
+enum ExceptionHandler appendGameRecordAction(struct GameGrid *gameGrid, enum GameRecordFrameType type, int playerId,
+                                             struct GridPoint **changedTiles, int numberOfChangedTiles, int scoreDelta)
+{
+    unsigned char *frame = (unsigned char *)malloc(16 + numberOfChangedTiles * 6);
+    size_t frameSize = 0;
+
+    frame[frameSize++] = (unsigned char)type;
+    frame[frameSize++] = (unsigned char)playerId;
+    frameSize += writeVarint(frame + frameSize, (uint32_t)numberOfChangedTiles);
+    for (int i = 0; i < numberOfChangedTiles; i++)
+    {
+        const struct GridPoint *p = changedTiles[i];
+        frameSize += writeVarint(frame + frameSize, (uint32_t)(p->x * gameGrid->cols + p->y));
+        frame[frameSize++] = packTile(p->numberOfFishes, p->owner ? p->owner->id : 0);
+    }
+
+    frame[frameSize++] = scoreDelta != 0;
+    if (scoreDelta != 0)
+    {
+        frame[frameSize++] = (unsigned char)playerId;
+        frameSize += writeVarint(frame + frameSize, ((uint32_t)scoreDelta << 1) ^ (uint32_t)(scoreDelta >> 31));
+    }
+
+    char *path = gameRecordPath(gameGrid);
+    enum ExceptionHandler status = appendGameRecordBytes(path, "ab", frame, frameSize);
+
+    free(path);
+    free(frame);
+    return status;
+}
+
+long gameRecordSize(const struct GameGrid *gameGrid)
+{
+    char *path = gameRecordPath(gameGrid);
+    FILE *file = fopen(path, "rb");
+    free(path);
+    if (file == NULL)
+        return -1;
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+char *gameRecordPath(const struct GameGrid *gameGrid)
+{
+    const size_t length = strlen(gameGrid->outputFile) + strlen(GAME_RECORD_EXTENSION) + 1;
+    char *path = (char *)malloc(length);
+    snprintf(path, length, "%s%s", gameGrid->outputFile, GAME_RECORD_EXTENSION);
+    return path;
+}
+
+enum ExceptionHandler startGameRecord(const char *path, const struct BinaryBoard *board)
+{
+    if (!binaryBoardFits(board))
+        return (enum ExceptionHandler)FileFormatException;
+
+    const size_t numberOfTiles = (size_t)board->rows * board->cols;
+    unsigned char *bytes = (unsigned char *)malloc(GAME_RECORD_HEADER_SIZE + 2 + MAX_PLAYER_ID * (6 + BINARY_BOARD_MAX_NAME) + numberOfTiles);
+
+    memcpy(bytes, "PNGR", 4);
+    bytes[4] = GAME_RECORD_VERSION;
+    bytes[5] = 0;
+    writeUint16(bytes + 6, board->rows);
+    writeUint16(bytes + 8, board->cols);
+
+    const size_t size = GAME_RECORD_HEADER_SIZE + encodeKeyframe(bytes + GAME_RECORD_HEADER_SIZE, board);
+    enum ExceptionHandler status = appendGameRecordBytes(path, "wb", bytes, size);
+
+    free(bytes);
+    return status;
+}
+
+enum ExceptionHandler rotateGameRecord(const char *path)
+{
+    // <path>.1, <path>.2, ... the first name not taken yet
+    const size_t length = strlen(path) + 12;
+    char *rotatedPath = (char *)malloc(length);
+    for (int i = 1;; i++)
+    {
+        snprintf(rotatedPath, length, "%s.%d", path, i);
+        FILE *file = fopen(rotatedPath, "rb");
+        if (file == NULL)
+            break;
+        fclose(file);
+    }
+
+    const int renamed = rename(path, rotatedPath);
+    free(rotatedPath);
+    return renamed == 0 ? (enum ExceptionHandler)NoError : (enum ExceptionHandler)FileOpenException;
+}
+
+enum ExceptionHandler appendGameRecordBytes(const char *path, const char *mode, const unsigned char *bytes, size_t size)
+{
+    FILE *file = fopen(path, mode);
+    if (file == NULL)
+        return (enum ExceptionHandler)FileOpenException;
+
+    const size_t written = fwrite(bytes, 1, size, file);
+    fclose(file);
+
+    return written == size ? (enum ExceptionHandler)NoError : (enum ExceptionHandler)FileOpenException;
+}
+
+size_t encodeKeyframe(unsigned char *at, const struct BinaryBoard *board)
+{
+    size_t size = 0;
+    at[size++] = GameRecordKeyframe;
+    at[size++] = (unsigned char)board->numberOfPlayers;
+
+    for (int i = 0; i < board->numberOfPlayers; i++)
+    {
+        const struct BinaryBoardPlayer *player = &board->players[i];
+        const size_t nameLength = strnlen(player->name, BINARY_BOARD_MAX_NAME);
+
+        at[size] = (unsigned char)player->id;
+        at[size + 1] = (unsigned char)nameLength;
+        writeUint32(at + size + 2, (uint32_t)player->collectedFishes);
+        memcpy(at + size + 6, player->name, nameLength);
+        size += 6 + nameLength;
+    }
+
+    const size_t numberOfTiles = (size_t)board->rows * board->cols;
+    memcpy(at + size, board->tiles, numberOfTiles);
+
+    return size + numberOfTiles;
+}
+
+bool havePlayersChanged(const struct BinaryBoard *recorded, const struct BinaryBoard *current)
+{
+    if (recorded->numberOfPlayers != current->numberOfPlayers)
+        return true;
+
+    for (int i = 0; i < current->numberOfPlayers; i++)
+    {
+        if (recorded->players[i].id != current->players[i].id || strcmp(recorded->players[i].name, current->players[i].name))
+            return true;
+    }
+    return false;
+}
+
+struct BinaryBoardPlayer *findRecordedPlayer(struct BinaryBoard *board, int id)
+{
+    for (int i = 0; i < board->numberOfPlayers; i++)
+    {
+        if (board->players[i].id == id)
+            return &board->players[i];
+    }
+    return NULL;
+}
+
+size_t writeVarint(unsigned char *at, uint32_t value)
+{
+    size_t size = 0;
+    while (value >= 0x80)
+    {
+        at[size++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    at[size++] = (unsigned char)value;
+    return size;
+}
+
+bool readVarint(struct GameRecordReader *reader, uint32_t *value)
+{
+    *value = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        if (reader->offset >= reader->size)
+            return false;
+
+        const unsigned char byte = reader->data[reader->offset++];
+        *value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
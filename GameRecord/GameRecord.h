@@ -0,0 +1,75 @@
+#ifndef GAME_RECORD_H
+#define GAME_RECORD_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "../GameGrid/Grid.h"
+#include "../GameGrid/BinaryBoard.h"
+#include "../Enums/ExceptionHandler.h"
+
+// Append-only record of a game, kept next to the output board (<outputFile>.record) when the
+// executable is built with PENGUINS_GAME_RECORD.
+//
+//   header: "PNGR" magic, u8 version, u8 reserved, u16 rows, u16 cols
+//   frames, each one starting with its u8 type:
+//     'K' keyframe: u8 number of players, for every player u8 id, u8 name length, i32 collected fish, name bytes,
+//                   then rows * cols packed tiles (see packTile)
+//     'E' changes made by the other players between our turns,
+//     'P' placement, 'M' movement:
+//                   u8 player id, varint number of tiles, for every tile varint index and the new packed tile,
+//                   u8 number of score changes, for every one of them u8 player id and a zigzag varint delta
+//
+// Every frame is one position of the game, frame 0 is always a keyframe. A later keyframe starts
+// over from a whole board: the players have changed or a new game of the same size has begun.
+// A record is never truncated, a damaged one or one of a different size is renamed to the first
+// free <outputFile>.record.N and a new record is started.
+
+#define GAME_RECORD_VERSION 1
+#define GAME_RECORD_EXTENSION ".record"
+
+enum GameRecordFrameType
+{
+    GameRecordKeyframe = 'K',
+    GameRecordExternalChanges = 'E',
+    GameRecordPlacement = 'P',
+    GameRecordMovement = 'M',
+};
+
+// sequential reader which reconstructs the positions one frame after another
+struct GameRecordReader
+{
+    unsigned char *data;
+    size_t size;
+    size_t offset;
+
+    // current position, its tiles are owned by the reader
+    struct BinaryBoard position;
+    unsigned char *tiles;
+
+    int ply;
+    enum GameRecordFrameType lastFrameType;
+    int lastPlayerId;
+};
+
+// reads the record into memory and positions the reader on the first keyframe (ply 0)
+enum ExceptionHandler openGameRecord(const char *path, struct GameRecordReader *reader);
+
+// applies the next frame, returns false when the record has ended (or is damaged)
+bool readNextGameRecordFrame(struct GameRecordReader *reader);
+
+void closeGameRecord(struct GameRecordReader *reader);
+
+// has to be called at the start of our turn, before the grid is modified: starts a new record
+// or appends whatever the other players have changed since the last recorded position, which is
+// taken from lastPosition when the caller knows it (see GameCache.h) or found by replaying the record,
+// a board which cannot follow that position (see isBoardContinuation) belongs to a new game and gets a keyframe
+enum ExceptionHandler beginGameRecordTurn(struct Player *myPlayer, struct GameGrid *gameGrid, const struct BinaryBoard *lastPosition);
+
+// appends our own action, changedTiles hold the tiles after the action has been made
+enum ExceptionHandler appendGameRecordAction(struct GameGrid *gameGrid, enum GameRecordFrameType type, int playerId,
+                                             struct GridPoint **changedTiles, int numberOfChangedTiles, int scoreDelta);
+
+// size of the record file in bytes, -1 if there is none
+long gameRecordSize(const struct GameGrid *gameGrid);
+
+#endif
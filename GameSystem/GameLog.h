@@ -0,0 +1,14 @@
+#ifndef GAME_LOG_H
+#define GAME_LOG_H
+
+#include <stdio.h>
+
+// progress messages of the engine, they go to the console of the executable and are compiled out
+// of the library (PENGUINS_LIBRARY), which must never write to stdout of its host
+#ifdef PENGUINS_LIBRARY
+#define gameLog(...) ((void)0)
+#else
+#define gameLog(...) printf(__VA_ARGS__)
+#endif
+
+#endif
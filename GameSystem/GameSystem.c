@@ -3,41 +3,75 @@
 #include "string.h"
 #include "../Enums/ExceptionHandler.h"
 #include "../Enums/GameState.h"
+#include "../GameGrid/BinaryBoard.h"
+#include "../GameRecord/GameRecord.h"
+#include "../GameCache/GameCache.h"
+#include "../Evaluation/Territory.h"
+#include "../Evaluation/TerritoryBatch.h"
+#include "./MoveStack.h"
+#include "./GameLog.h"
+#include "../GameGrid/BoardKernels.h"
 #include "stdlib.h"
 
-#define welcomeLine() printf("\n---- PROJECT \"PENGUINS\" ----\n\n");
+#define welcomeLine() gameLog("\n---- PROJECT \"PENGUINS\" ----\n\n");
 
 // =========================================
 // available public functions:
 
 enum ExceptionHandler setup(struct GameSystem *game, int argc, char *argv[]);
 enum ExceptionHandler performAction(struct GameSystem *game);
-void exitWithErrorMessage(enum ExceptionHandler error);
+enum ExceptionHandler decideAction(struct GameSystem *game, struct GridPoint **from, struct GridPoint **to);
+enum ExceptionHandler playAction(struct GameSystem *game, struct GridPoint *from, struct GridPoint *to);
+void freeGameSystemObject(struct GameSystem *game);
 
 // private functions:
 
-// Function to move a penguin from an initial point to a destination point
-enum ExceptionHandler moveAPenguin(struct GameGrid *gameGrid, struct GameSystem *game);
+// boards can be stored either in the text format (.txt) or in the binary one (.bin)
+bool hasSupportedBoardExtension(const char *fileName);
 
-// Function to place a penguin on the grid
-enum ExceptionHandler placeAPenguin(struct GameGrid *gameGrid, struct GameSystem *game);
+// allocates what the evaluation of the current board needs, once its dimensions are known
+void prepareAction(struct GameSystem *game);
+
+// Function to choose the initial point and the destination point of a penguin to move
+enum ExceptionHandler chooseMovement(struct GameSystem *game, struct GridPoint **from, struct GridPoint **to);
+
+// Function to choose the point to place a penguin on
+enum ExceptionHandler choosePlacement(struct GameSystem *game, struct GridPoint **to);
 
 // find a perfect placement point, e.g. 10 30 (the point returned will be the first one)
 struct GridPoint *findPerfectPointToPlaceRowWise(struct GameGrid *gameGrid);
 
-// find second best e.g. if there are no 'perfect' points available, then choose such a point which
-// is in the same row as the point with the highest possible fish number and at the same time it has
-// no obstacles between the initial point and the highest one
-struct GridPoint *findSecondBestPointToPlaceRowWise(struct GameGrid *gameGrid);
+// find second best e.g. if there are no 'perfect' points available, then choose the 10 tile from which
+// the most fish can be reached, counting every tile in the four directions up to the first obstacle
+// (the first one row by row among equal ones)
+struct GridPoint *findMostReachablePointToPlace(struct GameGrid *gameGrid);
+
+// both return the destination point and set the initial point of the penguin making the move
+struct GridPoint *findBestPointToMoveRowWise(struct GameGrid *gameGrid, struct GridPoint **initialPoint);
+
+struct GridPoint *findBestPointToMoveColWise(struct GameGrid *gameGrid, struct GridPoint **initialPoint);
+
+// territory balance (see Evaluation/Territory.h) of the positions after moving our penguin from[i] -> to[i],
+// all the moves are scored together by a single batch evaluation
+void evaluateMoves(struct GameSystem *game, struct GridPoint **from, struct GridPoint **to, int numberOfMoves, int *balances);
 
-struct GridPoint *findBestPointToMoveRowWise(struct GameGrid *gameGrid);
+// picks up the cache of our previous turn (see GameCache.h) if it belongs to the board just read
+void loadWarmStart(struct GameSystem *game);
 
-struct GridPoint *findBestPointToMoveColWise(struct GameGrid *gameGrid);
+// the last recorded position if the cache still describes it, NULL if the record has to be replayed
+const struct BinaryBoard *lastRecordedPosition(struct GameSystem *game);
 
 bool isTileNotTraversable(struct GameGrid *gameGrid, struct GridPoint x);
 
 bool isTileOurs(struct GameGrid *gameGrid, struct GridPoint x);
 
+// tells whether tile a comes before tile b in a scan which walks rows (or columns if columnWise is set)
+// in ascending order and the tiles inside them in the given direction (1 - ascending, -1 - descending),
+// a NULL b means that nothing has been found yet
+bool isVisitedBefore(const struct GridPoint *a, const struct GridPoint *b, bool columnWise, int direction);
+
+struct GridPoint *findFishInLine(struct GameGrid *gameGrid, const struct GridPoint *from, int dx, int dy, int fishNumber);
+
 // =========================================
 
 struct GameSystem
@@ -52,7 +86,7 @@ createGameSystemObject()
     obj.fullPlayersData = (char **)malloc(obj.maxNumberOfPlayers * sizeof(char *)); // allocate memory for max players
     for (int i = 0; i < obj.maxNumberOfPlayers; i++)
     {
-        obj.fullPlayersData[i] = (char *)malloc(1000 * sizeof(char)); // max length of a 1000 characters for a single player data line
+        obj.fullPlayersData[i] = (char *)malloc(MAX_PLAYER_DATA_LENGTH * sizeof(char)); // max length of a 1000 characters for a single player data line
         // e.g. the nickname, id and score
     }
 
@@ -61,51 +95,58 @@ createGameSystemObject()
     // setting function references
     obj.setup = &setup;
     obj.performAction = &performAction;
-    obj.exitWithErrorMessage = &exitWithErrorMessage;
+    obj.decideAction = &decideAction;
+    obj.playAction = &playAction;
 
     obj.numberOfPenguins = -1; // this will be written into after reading the cmd params
     obj.numberOfPlacedPenguins = 0;
 
+    obj.territoryBatchEvaluator = NULL; // created once the board dimensions are known
+    obj.moveStack = NULL;
+    obj.gameCache = NULL;
+    obj.recordUpToDate = false;
+
     return obj;
 }
 
-void exitWithErrorMessage(enum ExceptionHandler error)
+void freeGameSystemObject(struct GameSystem *game)
 {
-    // MessageBeep(MB_ICONEXCLAMATION);
-
-    switch (error)
-    {
-    case UnknownParamsException:
-    {
-        // MessageBox(NULL, "Unsupported command line parameters", "Error", MB_ICONWARNING);
-        exit(3);
-    }
-    case PenguinsNumValueException:
-    {
-        // MessageBox(NULL, "Unsupported number of penguins", "Error", MB_ICONWARNING);
-        exit(3);
-    }
-    case GamePhaseValueException:
-    {
-        // MessageBox(NULL, "Invalid game phase (should be: movement/placement)", "Error", MB_ICONWARNING);
-        exit(3);
-    }
-    case FileFormatException:
-    {
-        // MessageBox(NULL, "Invalid file format. Only .txt is supported", "Error", MB_ICONWARNING);
-        exit(3);
-    }
-    case FileOpenException:
+    for (int i = 0; i < game->maxNumberOfPlayers; i++)
     {
-        // MessageBox(NULL, "Error while opening the file. Please provide a valid path (relative to the .exe file)", "Error", MB_ICONWARNING);
-        exit(3);
-    }
-    case MoveImpossible:
-    {
-        // MessageBox(NULL, "Impossible to make a move for current phase", "Error", MB_ICONWARNING);
-        exit(3);
-    }
+        free(game->fullPlayersData[i]);
     }
+    free(game->fullPlayersData);
+    game->fullPlayersData = NULL;
+
+    if (game->territoryBatchEvaluator != NULL)
+        freeTerritoryBatchEvaluatorObject(game->territoryBatchEvaluator);
+    free(game->territoryBatchEvaluator);
+    game->territoryBatchEvaluator = NULL;
+
+    if (game->moveStack != NULL)
+        freeMoveStackObject(game->moveStack);
+    free(game->moveStack);
+    game->moveStack = NULL;
+
+    if (game->gameCache != NULL)
+        closeGameCache(game->gameCache);
+    free(game->gameCache);
+    game->gameCache = NULL;
+
+    if (game->gameGrid != NULL)
+        freeGameGridObject(game->gameGrid);
+}
+
+bool hasSupportedBoardExtension(const char *fileName)
+{
+    const char *suffix = ".txt";
+    size_t suffixLength = strlen(suffix);
+    size_t fileNameLength = strlen(fileName);
+
+    if (fileNameLength >= suffixLength && !strcmp(fileName + (fileNameLength - suffixLength), suffix))
+        return true;
+
+    return hasBinaryBoardExtension(fileName);
 }
 
 enum ExceptionHandler setup(struct GameSystem *game, int argc, char *argv[])
@@ -119,7 +160,7 @@ enum ExceptionHandler setup(struct GameSystem *game, int argc, char *argv[])
 
     for (int i = 0; i < argc; i++)
     {
-        printf("%s\n", argv[i]);
+        gameLog("%s\n", argv[i]);
     }
 
     switch (argc)
@@ -145,13 +186,7 @@ enum ExceptionHandler setup(struct GameSystem *game, int argc, char *argv[])
         if (sscanf(argv[2], "penguins=%d", &game->numberOfPenguins) == 0)
             return (enum ExceptionHandler)PenguinsNumValueException;
 
-        const char *suffix = ".txt";
-        size_t suffixLength = strlen(suffix);
-        size_t inputLen = strlen(argv[3]); // lengths of file names
-        size_t outputLen = strlen(argv[4]);
-
-        if (inputLen >= suffixLength && strcmp(argv[3] + (inputLen - suffixLength), suffix) != 0 ||
-            outputLen >= suffixLength && strcmp(argv[4] + (outputLen - suffixLength), suffix) != 0)
+        if (!hasSupportedBoardExtension(argv[3]) || !hasSupportedBoardExtension(argv[4]))
         {
             return (enum ExceptionHandler)FileFormatException;
         }
@@ -182,13 +217,7 @@ enum ExceptionHandler setup(struct GameSystem *game, int argc, char *argv[])
 
         game->phase = (enum GameState)MovementPhase;
 
-        const char *suffix = ".txt";
-        size_t suffixLength = strlen(suffix);
-        size_t inputLen = strlen(argv[2]); // lengths of file names
-        size_t outputLen = strlen(argv[3]);
-
-        if (inputLen >= suffixLength && strcmp(argv[2] + (inputLen - suffixLength), suffix) != 0 ||
-            outputLen >= suffixLength && strcmp(argv[3] + (outputLen - suffixLength), suffix) != 0)
+        if (!hasSupportedBoardExtension(argv[2]) || !hasSupportedBoardExtension(argv[3]))
         {
             return (enum ExceptionHandler)FileFormatException;
         }
@@ -203,15 +232,8 @@ enum ExceptionHandler setup(struct GameSystem *game, int argc, char *argv[])
         if (strcmp(argv[1], "name"))
             return (enum ExceptionHandler)UnknownParamsException;
 
-        const char *playerName = game->myPlayer.name;
-        size_t msgSize = strlen("Player's name: ") + strlen(playerName) + 1;
-        char *msg = (char *)malloc(msgSize);
-        snprintf(msg, msgSize, "Player's name: %s", playerName);
-
-        // MessageBox(NULL, msg, "Information", MB_ICONINFORMATION);
-        // free(msg);
-
-        exit(0);
+        // only our name was asked for, the phase stays unset and there is no action to perform
+        // MessageBox(NULL, "Player's name: ...", "Information", MB_ICONINFORMATION);
 
         break;
     }
@@ -226,149 +248,233 @@ enum ExceptionHandler setup(struct GameSystem *game, int argc, char *argv[])
 
 enum ExceptionHandler performAction(struct GameSystem *game)
 {
+    prepareAction(game);
+#ifdef PENGUINS_WARM_START
+    loadWarmStart(game);
+#endif
+
+    struct GridPoint *from, *to;
+    enum ExceptionHandler decideStatus = decideAction(game, &from, &to);
+    if (decideStatus != NoError)
+        return decideStatus;
+
+    struct GameGrid *gameGrid = game->gameGrid;
+#ifdef PENGUINS_GAME_RECORD
+    // the record is optional, failing to write it must not cost us the turn
+    const bool recording = beginGameRecordTurn(&game->myPlayer, gameGrid, lastRecordedPosition(game)) == NoError;
+    const int collectedFishes = to->numberOfFishes;
+#endif
+
+    enum ExceptionHandler playStatus = playAction(game, from, to);
+    if (playStatus != NoError)
+        return playStatus;
+
+#ifdef PENGUINS_GAME_RECORD
+    if (recording)
+    {
+        struct GridPoint *changedTiles[] = {from, to};
+        game->recordUpToDate =
+            from == NULL ? appendGameRecordAction(gameGrid, GameRecordPlacement, game->myPlayer.id, changedTiles + 1, 1, collectedFishes) == NoError
+                         : appendGameRecordAction(gameGrid, GameRecordMovement, game->myPlayer.id, changedTiles, 2, collectedFishes) == NoError;
+    }
+#endif
+
+    enum ExceptionHandler writeStatus = (enum ExceptionHandler)gameGrid->writeGridData(&game->myPlayer, gameGrid);
+
+#ifdef PENGUINS_WARM_START
+    // like the record, the cache is optional and failing to write it must not cost us the turn
+    if (writeStatus == NoError)
+    {
+        const long recordSize = game->recordUpToDate ? gameRecordSize(gameGrid) : -1;
+        saveGameCache(&game->myPlayer, gameGrid, recordSize >= 0 ? (uint32_t)recordSize : GAME_CACHE_NO_RECORD);
+    }
+#endif
+
+    return writeStatus;
+}
+
+void prepareAction(struct GameSystem *game)
+{
+    // the dimensions of the board are known only after reading it
+    if (game->territoryBatchEvaluator == NULL)
+    {
+        game->territoryBatchEvaluator = (struct TerritoryBatchEvaluator *)malloc(sizeof(struct TerritoryBatchEvaluator));
+        *(game->territoryBatchEvaluator) = createTerritoryBatchEvaluatorObject(game->gameGrid->rows, game->gameGrid->cols);
+    }
+
+    // no line of play can be longer than the number of tiles
+    if (game->moveStack == NULL)
+    {
+        game->moveStack = (struct MoveStack *)malloc(sizeof(struct MoveStack));
+        *(game->moveStack) = createMoveStackObject(game->gameGrid->rows * game->gameGrid->cols);
+    }
+}
+
+enum ExceptionHandler decideAction(struct GameSystem *game, struct GridPoint **from, struct GridPoint **to)
+{
+    prepareAction(game);
+
+    *from = NULL;
+    *to = NULL;
     switch (game->phase)
     {
     case (enum GameState)PlacingPhase:
     {
-        return placeAPenguin(game->gameGrid, game);
+        return choosePlacement(game, to);
     }
     case (enum GameState)MovementPhase:
     {
-        return moveAPenguin(game->gameGrid, game);
+        return chooseMovement(game, from, to);
+    }
+    default:
+    {
+        return (enum ExceptionHandler)GamePhaseValueException;
+    }
+    }
+}
+
+enum ExceptionHandler playAction(struct GameSystem *game, struct GridPoint *from, struct GridPoint *to)
+{
+    if (from == NULL)
+    {
+        if (!makePlacement(game->moveStack, game->gameGrid, &game->myPlayer, to))
+            return (enum ExceptionHandler)MoveImpossible;
+        game->numberOfPlacedPenguins++;
+    }
+    else if (!makeMove(game->moveStack, game->gameGrid, &game->myPlayer, from, to))
+        return (enum ExceptionHandler)MoveImpossible;
+
+    return (enum ExceptionHandler)NoError;
+}
+
+void loadWarmStart(struct GameSystem *game)
+{
+    struct GameCache *cache = (struct GameCache *)malloc(sizeof(struct GameCache));
+    if (loadGameCache(game->gameGrid->outputFile, cache) != NoError)
+    {
+        free(cache);
+        return;
     }
+
+    if (!matchGameCache(cache, &game->myPlayer, game->gameGrid))
+    {
+        gameLog("\ncache of a different game, starting cold");
+        closeGameCache(cache);
+        free(cache);
+        return;
     }
+
+    gameLog("\nwarm start from the cache of our last turn");
+    game->gameCache = cache;
 }
 
-enum ExceptionHandler placeAPenguin(struct GameGrid *gameGrid, struct GameSystem *game)
+const struct BinaryBoard *lastRecordedPosition(struct GameSystem *game)
 {
-    const struct Player *ourPlayer = &game->myPlayer;
+    // nothing else may have been appended to the record since the cache was written
+    if (game->gameCache == NULL || game->gameCache->recordSize == GAME_CACHE_NO_RECORD)
+        return NULL;
+
+    const long size = gameRecordSize(game->gameGrid);
+    return size >= 0 && (uint32_t)size == game->gameCache->recordSize ? &game->gameCache->board : NULL;
+}
 
-    int x, y;
+enum ExceptionHandler choosePlacement(struct GameSystem *game, struct GridPoint **to)
+{
+    if (game->numberOfPenguins >= 0 && game->numberOfPlacedPenguins >= game->numberOfPenguins)
+        return (enum ExceptionHandler)MoveImpossible;
 
-    struct GridPoint *p = findPerfectPointToPlaceRowWise(gameGrid);
+    struct GridPoint *p = findPerfectPointToPlaceRowWise(game->gameGrid);
     if (p == NULL)
     {
-        printf("\nperfect nulled");
-        p = findSecondBestPointToPlaceRowWise(gameGrid);
+        gameLog("\nperfect nulled");
+        p = findMostReachablePointToPlace(game->gameGrid);
     }
     if (p == NULL)
     {
         return (enum ExceptionHandler)MoveImpossible;
     }
-    printf("\npoint chosen: %d %d %d", p->x, p->y, p->numberOfFishes);
-
-    p->owner = &game->myPlayer;
-    p->numberOfFishes = 0;
-    game->myPlayer.collectedFishes++;
+    gameLog("\npoint chosen: %d %d %d", p->x, p->y, p->numberOfFishes);
 
-    return (enum ExceptionHandler)game->gameGrid->writeGridData(&game->myPlayer, game->gameGrid);
+    *to = p;
+    return (enum ExceptionHandler)NoError;
 }
 
 struct GridPoint *findPerfectPointToPlaceRowWise(struct GameGrid *gameGrid)
 {
     // perfect means that we have found two adjecent cells where one of which is a 10 and the second one is 30
     // (a perfect place)
+    // both passes compare whole rows of the fish masks at once, the first tile row by row wins
 
-    // first left-right: 10 30
-    for (int i = 0; i < gameGrid->rows; i++)
-    {
-        for (int j = 0; j < gameGrid->cols - 1; j++)
-        {
-            // printf("\nconsidering: %d %d %d and %d %d %d", i, j, gameGrid->grid[i][j].numberOfFishes, i, j + 1, gameGrid->grid[i][j + 1].numberOfFishes);
-            if (gameGrid->grid[i][j].numberOfFishes == 1 && gameGrid->grid[i][j + 1].numberOfFishes == 3)
-            {
-                return &gameGrid->grid[i][j];
-            }
-        }
-    }
+    const struct BoardKernels *kernels = gameGrid->kernels;
 
-    // secondly right-left: 30 10
-    for (int i = 0; i < gameGrid->rows; i++)
+    // first left-right: 10 30, secondly right-left: 30 10
+    for (int direction = 1; direction >= -1; direction -= 2)
     {
-        for (int j = 1; j < gameGrid->cols; j++)
-        {
-            // printf("\nconsidering: %d %d %d and %d %d %d", i, j, gameGrid->grid[i][j].numberOfFishes, i, j + 1, gameGrid->grid[i][j + 1].numberOfFishes);
-            if (gameGrid->grid[i][j].numberOfFishes == 1 && gameGrid->grid[i][j - 1].numberOfFishes == 3)
-            {
-                return &gameGrid->grid[i][j];
-            }
-        }
+        int index = kernels->findAdjacentPair(gameGrid->fishMasks[1], gameGrid->fishMasks[3], gameGrid->rows, gameGrid->cols,
+                                              gameGrid->maskWords, direction);
+        if (index >= 0)
+            return &gameGrid->grid[index / gameGrid->cols][index % gameGrid->cols];
     }
     return NULL;
 }
 
-struct GridPoint *findSecondBestPointToPlaceRowWise(struct GameGrid *gameGrid)
+struct GridPoint *findMostReachablePointToPlace(struct GameGrid *gameGrid)
 {
-    // perfect means that we have found two adjecent cells where one of which is a 10 and the second one is 30
-    // (a perfect place)
+    const int rows = gameGrid->rows;
+    const int cols = gameGrid->cols;
 
-    // first left-right: 10 10 10 20
-    for (int fishNumber = 3; fishNumber >= 1; fishNumber--)
+    // fish of the unbroken run of tiles ending right before the current tile, in the direction of the sweep,
+    // a tile without fish (a penguin or an empty one) ends every run
+    int *reachable = (int *)malloc((size_t)rows * cols * sizeof(int));
+    int *columnRuns = (int *)calloc(cols, sizeof(int));
+
+    // first sweep from the top left corner: the runs coming from the west and from the north
+    for (int i = 0; i < rows; i++)
     {
-        for (int i = 0; i < gameGrid->rows; i++)
+        int rowRun = 0;
+        for (int j = 0; j < cols; j++)
         {
-            for (int j = 0; j < gameGrid->cols; j++)
-            {
-                if (gameGrid->grid[i][j].numberOfFishes != 1)
-                    continue;
-                for (int k = j + 1; k < gameGrid->cols; k++)
-                {
-                    // we cannot allow any untraversable points to be in between
-                    if (gameGrid->grid[i][k].owner != NULL)
-                        break;
-                    // this is the situation in terms of a row: 00 10 10 10 30
-                    // then the second from left point is gonna get returned
-                    if (gameGrid->grid[i][k].numberOfFishes == fishNumber)
-                    {
-                        return &gameGrid->grid[i][j];
-                    }
-                }
-            }
+            const int fishes = gameGrid->grid[i][j].numberOfFishes;
+            reachable[i * cols + j] = rowRun + columnRuns[j];
+            rowRun = fishes > 0 ? rowRun + fishes : 0;
+            columnRuns[j] = fishes > 0 ? columnRuns[j] + fishes : 0;
         }
     }
-    // secondly right-left: 20 10 10 10
-    for (int fishNumber = 3; fishNumber >= 1; fishNumber--)
+
+    // then from the bottom right corner: the runs from the east and from the south, the scores are complete
+    // so the best tile can be picked on the way (walking backwards, the last of the equal ones is the first row by row)
+    memset(columnRuns, 0, cols * sizeof(int));
+    struct GridPoint *best = NULL;
+    int bestScore = -1;
+    for (int i = rows - 1; i >= 0; i--)
     {
-        for (int i = 0; i < gameGrid->rows; i++)
+        int rowRun = 0;
+        for (int j = cols - 1; j >= 0; j--)
         {
-            for (int j = gameGrid->cols - 1; j >= 0; j--)
+            struct GridPoint *p = &gameGrid->grid[i][j];
+            const int score = reachable[i * cols + j] + rowRun + columnRuns[j];
+            if (p->numberOfFishes == 1 && p->owner == NULL && score >= bestScore)
             {
-                if (gameGrid->grid[i][j].numberOfFishes != 1)
-                    continue;
-                for (int k = j - 1; k >= 0; k--)
-                {
-                    // we cannot allow any untraversable points to be in between
-                    if (gameGrid->grid[i][k].owner != NULL)
-                        break;
-                    // this is the situation in terms of a row: 00 10 10 10 30
-                    // then the second from left point is gonna get returned
-                    if (gameGrid->grid[i][k].numberOfFishes == fishNumber)
-                    {
-                        return &gameGrid->grid[i][j];
-                    }
-                }
+                best = p;
+                bestScore = score;
             }
+            rowRun = p->numberOfFishes > 0 ? rowRun + p->numberOfFishes : 0;
+            columnRuns[j] = p->numberOfFishes > 0 ? columnRuns[j] + p->numberOfFishes : 0;
         }
     }
 
-    // if all of them fail, just pick first 10 in the grid
-    for (int i = 0; i < gameGrid->rows; i++)
-    {
-        for (int j = 0; j < gameGrid->cols; j++)
-        {
-            if (gameGrid->grid[i][j].numberOfFishes == 1)
-                return &gameGrid->grid[i][j];
-        }
-    }
+    free(reachable);
+    free(columnRuns);
 
-    // no available placement tile
-    return NULL;
+    // NULL if there is no available placement tile
+    return best;
 }
 
-enum ExceptionHandler moveAPenguin(struct GameGrid *gameGrid, struct GameSystem *game)
+enum ExceptionHandler chooseMovement(struct GameSystem *game, struct GridPoint **from, struct GridPoint **to)
 {
-    struct GridPoint *p1 = findBestPointToMoveRowWise(gameGrid);
-    struct GridPoint *p2 = findBestPointToMoveColWise(gameGrid); // these are the destination points
+    struct GridPoint *rowInitialPoint, *colInitialPoint;
+    struct GridPoint *p1 = findBestPointToMoveRowWise(game->gameGrid, &rowInitialPoint);
+    struct GridPoint *p2 = findBestPointToMoveColWise(game->gameGrid, &colInitialPoint); // these are the destination points
 
     if (p1 == NULL && p2 == NULL)
         return (enum ExceptionHandler)MoveImpossible;
@@ -378,31 +484,61 @@ enum ExceptionHandler moveAPenguin(struct GameGrid *gameGrid, struct GameSystem
     if (p1 == NULL)
     {
         movePoint = p2;
-        initialPoint = findBestPointToMoveColWise(gameGrid);
+        initialPoint = colInitialPoint;
     }
     else if (p2 == NULL)
     {
         movePoint = p1;
-        initialPoint = findBestPointToMoveRowWise(gameGrid);
+        initialPoint = rowInitialPoint;
     }
     else
     {
-        movePoint = p1->numberOfFishes >= p2->numberOfFishes ? p1 : p2;
-        initialPoint = p1->numberOfFishes >= p2->numberOfFishes ? findBestPointToMoveRowWise(gameGrid) : findBestPointToMoveColWise(gameGrid);
+        bool rowWise = p1->numberOfFishes > p2->numberOfFishes;
+
+        // equal catches are decided by the territory we are left with after the move
+        if (p1->numberOfFishes == p2->numberOfFishes)
+        {
+            struct GridPoint *candidateFrom[] = {rowInitialPoint, colInitialPoint};
+            struct GridPoint *candidateTo[] = {p1, p2};
+            int balances[2];
+            evaluateMoves(game, candidateFrom, candidateTo, 2, balances);
+            rowWise = balances[0] >= balances[1];
+        }
+
+        movePoint = rowWise ? p1 : p2;
+        initialPoint = rowWise ? rowInitialPoint : colInitialPoint;
     }
-    // calling these function here once more will return the value of the static initialPoint inside them
 
-    printf("\ninitialPoint: %d %d %d", initialPoint->x, initialPoint->y, initialPoint->numberOfFishes);
-    printf("\nmovePoint: %d %d %d", movePoint->x, movePoint->y, movePoint->numberOfFishes);
+    gameLog("\ninitialPoint: %d %d %d", initialPoint->x, initialPoint->y, initialPoint->numberOfFishes);
+    gameLog("\nmovePoint: %d %d %d", movePoint->x, movePoint->y, movePoint->numberOfFishes);
+
+    *from = initialPoint;
+    *to = movePoint;
+    return (enum ExceptionHandler)NoError;
+}
+
+void evaluateMoves(struct GameSystem *game, struct GridPoint **from, struct GridPoint **to, int numberOfMoves, int *balances)
+{
+    if (numberOfMoves <= 0)
+        return;
+
+    struct TerritoryCandidate *candidates = (struct TerritoryCandidate *)malloc(numberOfMoves * sizeof(struct TerritoryCandidate));
+    struct TerritoryScore *scores = (struct TerritoryScore *)malloc(numberOfMoves * sizeof(struct TerritoryScore));
 
-    initialPoint->owner = NULL;
+    for (int i = 0; i < numberOfMoves; i++)
+    {
+        candidates[i].from = from[i];
+        candidates[i].to = to[i];
+        candidates[i].playerId = game->myPlayer.id;
+    }
 
-    game->myPlayer.collectedFishes += movePoint->numberOfFishes;
+    evaluateTerritoryBatch(game->territoryBatchEvaluator, game->gameGrid, candidates, numberOfMoves, scores);
 
-    movePoint->owner = &game->myPlayer;
-    movePoint->numberOfFishes = 0;
+    for (int i = 0; i < numberOfMoves; i++)
+        balances[i] = territoryBalance(&scores[i], game->myPlayer.id);
 
-    return (enum ExceptionHandler)game->gameGrid->writeGridData(&game->myPlayer, game->gameGrid);
+    free(candidates);
+    free(scores);
 }
 
 bool isTileNotTraversable(struct GameGrid *gameGrid, struct GridPoint x)
@@ -415,62 +551,84 @@ bool isTileOurs(struct GameGrid *gameGrid, struct GridPoint x)
     return x.owner == &gameGrid->gameInstance->myPlayer;
 }
 
-// after first call it will return the destination point,
-// second call will return the initial point
-struct GridPoint *findBestPointToMoveRowWise(struct GameGrid *gameGrid)
+bool isVisitedBefore(const struct GridPoint *a, const struct GridPoint *b, bool columnWise, int direction)
 {
+    if (b == NULL)
+        return true;
 
-    static struct GridPoint *initialPoint = NULL;
-    if (initialPoint != NULL)
-        return initialPoint;
+    const int majorA = columnWise ? a->y : a->x;
+    const int majorB = columnWise ? b->y : b->x;
+    if (majorA != majorB)
+        return majorA < majorB;
 
-    // looking for a point to the right
-    for (int fishNumber = 3; fishNumber >= 1; fishNumber--)
-    {
-        for (int i = 0; i < gameGrid->rows; i++)
-        {
-            for (int j = 0; j < gameGrid->cols; j++)
-            {
-                if (isTileNotTraversable(gameGrid, gameGrid->grid[i][j]) || !isTileOurs(gameGrid, gameGrid->grid[i][j]))
-                    continue;
+    const int minorA = columnWise ? a->x : a->y;
+    const int minorB = columnWise ? b->x : b->y;
+    return direction > 0 ? minorA < minorB : minorA > minorB;
+}
 
-                printf("we own %d %d", gameGrid->grid[i][j].x, gameGrid->grid[i][j].y);
+// walks from our penguin in the given direction until the first untraversable tile,
+// returns the first tile holding fishNumber fish or NULL
+struct GridPoint *findFishInLine(struct GameGrid *gameGrid, const struct GridPoint *from, int dx, int dy, int fishNumber)
+{
+    // traversable tiles are the ones with fish and our own (see isTileNotTraversable)
+    const int ourId = gameGrid->gameInstance->myPlayer.id;
 
-                for (int k = j + 1; k < gameGrid->cols; k++)
-                {
-                    if (isTileNotTraversable(gameGrid, gameGrid->grid[i][k]))
-                        break;
-                    if (gameGrid->grid[i][k].numberOfFishes == fishNumber)
-                    {
-                        initialPoint = &gameGrid->grid[i][j];
-                        return &gameGrid->grid[i][k];
-                    }
-                }
-            }
-        }
+    if (dx == 0)
+    {
+        const int words = gameGrid->maskWords;
+        const int row = from->x * words;
+        const int j = gameGrid->kernels->findInRow(gameGrid->fishMasks[0] + row, gameGrid->penguinMasks[ourId] + row,
+                                                   gameGrid->fishMasks[fishNumber] + row, gameGrid->cols, words, from->y, dy);
+        return j < 0 ? NULL : &gameGrid->grid[from->x][j];
     }
 
-    // looking for a point to the left
-    for (int fishNumber = 3; fishNumber >= 1; fishNumber--)
+    // a column of the transposed mirror is scanned exactly like a row
+    const int words = gameGrid->columnWords;
+    const int column = from->y * words;
+    const int i = gameGrid->columnKernels->findInRow(gameGrid->fishColumnMasks[0] + column, gameGrid->penguinColumnMasks[ourId] + column,
+                                                     gameGrid->fishColumnMasks[fishNumber] + column, gameGrid->rows, words, from->x, dx);
+    return i < 0 ? NULL : &gameGrid->grid[i][from->y];
+}
+
+struct GridPoint *findBestPointToMoveRowWise(struct GameGrid *gameGrid, struct GridPoint **initialPoint)
+{
+    *initialPoint = NULL;
+
+    const int ourId = gameGrid->gameInstance->myPlayer.id;
+    if (ourId < 0 || ourId > MAX_PLAYER_ID)
+        return NULL;
+
+    struct GridPoint **ourPenguins = gameGrid->penguins[ourId];
+    const int numberOfOurPenguins = gameGrid->numberOfPenguinsOf[ourId];
+
+    // looking for a point to the right, then to the left
+    // (penguins are visited in the same order as a row by row scan of the grid would visit them)
+    for (int direction = 1; direction >= -1; direction -= 2)
     {
-        for (int i = 0; i < gameGrid->rows; i++)
+        for (int fishNumber = 3; fishNumber >= 1; fishNumber--)
         {
-            for (int j = gameGrid->cols - 1; j >= 0; j--)
+            struct GridPoint *from = NULL;
+            struct GridPoint *to = NULL;
+
+            for (int n = 0; n < numberOfOurPenguins; n++)
             {
-                if (isTileNotTraversable(gameGrid, gameGrid->grid[i][j]) || !isTileOurs(gameGrid, gameGrid->grid[i][j]))
-                    continue;
+                struct GridPoint *p = ourPenguins[n];
+                if (direction > 0)
+                    gameLog("we own %d %d", p->x, p->y);
 
-                for (int k = j - 1; k >= 0; k--)
+                struct GridPoint *destination = findFishInLine(gameGrid, p, 0, direction, fishNumber);
+                if (destination != NULL && isVisitedBefore(p, from, false, direction))
                 {
-                    if (isTileNotTraversable(gameGrid, gameGrid->grid[i][k]))
-                        break;
-                    if (gameGrid->grid[i][k].numberOfFishes == fishNumber)
-                    {
-                        initialPoint = &gameGrid->grid[i][j];
-                        return &gameGrid->grid[i][k];
-                    }
+                    from = p;
+                    to = destination;
                 }
             }
+
+            if (to != NULL)
+            {
+                *initialPoint = from;
+                return to;
+            }
         }
     }
 
@@ -478,58 +636,40 @@ struct GridPoint *findBestPointToMoveRowWise(struct GameGrid *gameGrid)
     return NULL;
 }
 
-// after first call it will return the destination point,
-// second call will return the initial point
-struct GridPoint *findBestPointToMoveColWise(struct GameGrid *gameGrid)
+struct GridPoint *findBestPointToMoveColWise(struct GameGrid *gameGrid, struct GridPoint **initialPoint)
 {
-    static struct GridPoint *initialPoint = NULL;
-    if (initialPoint != NULL)
-        return initialPoint;
+    *initialPoint = NULL;
+
+    const int ourId = gameGrid->gameInstance->myPlayer.id;
+    if (ourId < 0 || ourId > MAX_PLAYER_ID)
+        return NULL;
+
+    struct GridPoint **ourPenguins = gameGrid->penguins[ourId];
+    const int numberOfOurPenguins = gameGrid->numberOfPenguinsOf[ourId];
 
-    // looking for a point to the bottom
-    for (int fishNumber = 3; fishNumber >= 1; fishNumber--)
+    // looking for a point to the bottom, then to the top
+    for (int direction = 1; direction >= -1; direction -= 2)
     {
-        for (int i = 0; i < gameGrid->cols; i++)
+        for (int fishNumber = 3; fishNumber >= 1; fishNumber--)
         {
-            for (int j = 0; j < gameGrid->rows; j++)
-            {
-                if (isTileNotTraversable(gameGrid, gameGrid->grid[j][i]) || !isTileOurs(gameGrid, gameGrid->grid[j][i]))
-                    continue;
+            struct GridPoint *from = NULL;
+            struct GridPoint *to = NULL;
 
-                for (int k = j + 1; k < gameGrid->rows; k++)
+            for (int n = 0; n < numberOfOurPenguins; n++)
+            {
+                struct GridPoint *p = ourPenguins[n];
+                struct GridPoint *destination = findFishInLine(gameGrid, p, direction, 0, fishNumber);
+                if (destination != NULL && isVisitedBefore(p, from, true, direction))
                 {
-                    if (isTileNotTraversable(gameGrid, gameGrid->grid[k][i]))
-                        break;
-                    if (gameGrid->grid[k][i].numberOfFishes == fishNumber)
-                    {
-                        initialPoint = &gameGrid->grid[j][i];
-                        return &gameGrid->grid[k][i];
-                    }
+                    from = p;
+                    to = destination;
                 }
             }
-        }
-    }
 
-    // looking for a point to the top
-    for (int fishNumber = 3; fishNumber >= 1; fishNumber--)
-    {
-        for (int i = 0; i < gameGrid->cols; i++)
-        {
-            for (int j = gameGrid->rows - 1; j >= 0; j--)
+            if (to != NULL)
             {
-                if (isTileNotTraversable(gameGrid, gameGrid->grid[j][i]) || !isTileOurs(gameGrid, gameGrid->grid[j][i]))
-                    continue;
-
-                for (int k = j - 1; k >= 0; k--)
-                {
-                    if (isTileNotTraversable(gameGrid, gameGrid->grid[k][i]))
-                        break;
-                    if (gameGrid->grid[k][i].numberOfFishes == fishNumber)
-                    {
-                        initialPoint = &gameGrid->grid[j][i];
-                        return &gameGrid->grid[k][i];
-                    }
-                }
+                *initialPoint = from;
+                return to;
             }
         }
     }
@@ -7,6 +7,13 @@
 #include "../Enums/ExceptionHandler.h"
 #include "../GameGrid/Grid.h"
 
+// length of a single line of fullPlayersData, terminator included
+#define MAX_PLAYER_DATA_LENGTH 1000
+
+struct TerritoryBatchEvaluator;
+struct MoveStack;
+struct GameCache;
+
 struct GameSystem
 {
     struct GameGrid *gameGrid;
@@ -22,16 +29,37 @@ struct GameSystem
     int maxNumberOfPlayers;
     int numberOfPlayers;
 
+    // masks reused by every territory evaluation of the current board
+    struct TerritoryBatchEvaluator *territoryBatchEvaluator;
+
+    // undo stack of every placement and movement made on the grid, used to explore moves in place
+    struct MoveStack *moveStack;
+
+    // what we knew at the end of our previous turn (see GameCache.h), NULL when starting cold
+    struct GameCache *gameCache;
+
+    // set once our action has been appended to the game record
+    bool recordUpToDate;
+
     // Function to set up the game and read board data from a file
     enum ExceptionHandler (*setup)(struct GameSystem *game, int argc, char *argv[]);
 
-    void (*exitWithErrorMessage)(enum ExceptionHandler error);
-
-    // Function to ask for player action based on the current game phase (Placing, Movement, Finish)
+    // Function to ask for player action based on the current game phase (Placing, Movement, Finish),
+    // the action is played and written to the output board
     enum ExceptionHandler (*performAction)(struct GameSystem *game);
+
+    // Function to choose our action on the current grid without touching it or any file,
+    // from is NULL for a placement
+    enum ExceptionHandler (*decideAction)(struct GameSystem *game, struct GridPoint **from, struct GridPoint **to);
+
+    // Function to play an action chosen by decideAction on the grid, MoveImpossible if it cannot be made
+    enum ExceptionHandler (*playAction)(struct GameSystem *game, struct GridPoint *from, struct GridPoint *to);
 };
 
 // creates the object and sets all default values including references to functions
 struct GameSystem createGameSystemObject();
 
+// releases everything the game and its grid have allocated (the structs themselves belong to the caller)
+void freeGameSystemObject(struct GameSystem *game);
+
 #endif
\ No newline at end of file
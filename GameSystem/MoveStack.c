@@ -0,0 +1,87 @@
+#include "MoveStack.h"
+#include "stdlib.h"
+
+// =========================================
+// available public functions:
+
+struct MoveStack createMoveStackObject(int maxNumberOfMoves);
+void freeMoveStackObject(struct MoveStack *stack);
+bool makePlacement(struct MoveStack *stack, struct GameGrid *gameGrid, struct Player *player, struct GridPoint *tile);
+bool makeMove(struct MoveStack *stack, struct GameGrid *gameGrid, struct Player *player, struct GridPoint *from, struct GridPoint *to);
+void unmakeMove(struct MoveStack *stack, struct GameGrid *gameGrid);
+
+// private functions:
+
+void pushTileChange(struct MoveStack *stack, struct GameGrid *gameGrid, struct GridPoint *tile, int numberOfFishes,
+                    struct Player *owner, struct Player *player, int scoreDelta, bool startsMove);
+
+// =========================================
+
+struct MoveStack createMoveStackObject(int maxNumberOfMoves)
+{
+    struct MoveStack obj;
+
+    // a movement changes two tiles, a placement just one
+    obj.capacity = 2 * maxNumberOfMoves;
+    obj.entries = (struct MoveStackEntry *)malloc(obj.capacity * sizeof(struct MoveStackEntry));
+    obj.size = 0;
+
+    return obj;
+}
+
+void freeMoveStackObject(struct MoveStack *stack)
+{
+    free(stack->entries);
+    stack->entries = NULL;
+    stack->size = 0;
+    stack->capacity = 0;
+}
+
+bool makePlacement(struct MoveStack *stack, struct GameGrid *gameGrid, struct Player *player, struct GridPoint *tile)
+{
+    if (stack->size + 1 > stack->capacity)
+        return false;
+
+    pushTileChange(stack, gameGrid, tile, 0, player, player, tile->numberOfFishes, true);
+    return true;
+}
+
+bool makeMove(struct MoveStack *stack, struct GameGrid *gameGrid, struct Player *player, struct GridPoint *from, struct GridPoint *to)
+{
+    if (stack->size + 2 > stack->capacity)
+        return false;
+
+    // the penguin leaves first, so the penguin list of the player never grows during a movement
+    pushTileChange(stack, gameGrid, from, 0, NULL, player, 0, true);
+    pushTileChange(stack, gameGrid, to, 0, player, player, to->numberOfFishes, false);
+    return true;
+}
+
+void unmakeMove(struct MoveStack *stack, struct GameGrid *gameGrid)
+{
+    while (stack->size > 0)
+    {
+        const struct MoveStackEntry *entry = &stack->entries[--stack->size];
+
+        entry->player->collectedFishes -= entry->scoreDelta;
+        updateTile(gameGrid, entry->tile, entry->previousFishes, entry->previousOwner);
+
+        if (entry->startsMove)
+            break;
+    }
+}
+
+void pushTileChange(struct MoveStack *stack, struct GameGrid *gameGrid, struct GridPoint *tile, int numberOfFishes,
+                    struct Player *owner, struct Player *player, int scoreDelta, bool startsMove)
+{
+    struct MoveStackEntry *entry = &stack->entries[stack->size++];
+    entry->tile = tile;
+    entry->previousFishes = tile->numberOfFishes;
+    entry->previousOwner = tile->owner;
+    entry->player = player;
+    entry->scoreDelta = scoreDelta;
+    entry->startsMove = startsMove;
+
+    player->collectedFishes += scoreDelta;
+    updateTile(gameGrid, tile, numberOfFishes, owner);
+}
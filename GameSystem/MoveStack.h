@@ -0,0 +1,47 @@
+#ifndef MOVE_STACK_H
+#define MOVE_STACK_H
+
+#include <stdbool.h>
+#include "../GameGrid/Grid.h"
+#include "../Player/Player.h"
+
+// make/unmake of placements and movements on the only copy of the grid: every changed tile
+// is pushed together with its previous content, so any line of play can be explored and
+// taken back in O(1) per move without copying the grid
+
+struct MoveStackEntry
+{
+    struct GridPoint *tile;
+    int previousFishes;
+    struct Player *previousOwner;
+
+    // fish collected by the player with this change
+    struct Player *player;
+    int scoreDelta;
+
+    // the first entry pushed by a move, unmakeMove pops entries up to and including it
+    bool startsMove;
+};
+
+struct MoveStack
+{
+    struct MoveStackEntry *entries;
+    int size;
+    int capacity;
+};
+
+// preallocates the stack for at most maxNumberOfMoves moves
+struct MoveStack createMoveStackObject(int maxNumberOfMoves);
+
+void freeMoveStackObject(struct MoveStack *stack);
+
+// put a new penguin of the player on the tile, returns false if the stack is full
+bool makePlacement(struct MoveStack *stack, struct GameGrid *gameGrid, struct Player *player, struct GridPoint *tile);
+
+// move the penguin of the player between tiles, returns false if the stack is full
+bool makeMove(struct MoveStack *stack, struct GameGrid *gameGrid, struct Player *player, struct GridPoint *from, struct GridPoint *to);
+
+// take back the last made placement or movement
+void unmakeMove(struct MoveStack *stack, struct GameGrid *gameGrid);
+
+#endif
@@ -0,0 +1,123 @@
+#include "Penguins.h"
+#include "stdlib.h"
+#include "string.h"
+#include "../GameSystem/GameSystem.h"
+#include "../GameGrid/Grid.h"
+
+// =========================================
+// available public functions:
+
+struct PenguinsContext *createPenguinsContext(const char *playerName);
+void destroyPenguinsContext(struct PenguinsContext *context);
+enum ExceptionHandler loadPenguinsBoard(struct PenguinsContext *context, const void *data, size_t size);
+enum ExceptionHandler decidePenguinsAction(struct PenguinsContext *context, enum GameState phase, int numberOfPenguins,
+                                           struct PenguinsAction *action);
+unsigned char *serialisePenguinsBoard(struct PenguinsContext *context, bool binary, size_t *size);
+
+// private functions:
+
+// fresh game and grid objects wired to each other, the same way main.c sets them up
+void resetPenguinsContext(struct PenguinsContext *context);
+
+// =========================================
+
+struct PenguinsContext
+{
+    char *playerName;
+
+    // everything a game needs lives here, the engine keeps no state outside of it
+    struct GameSystem game;
+    struct GameGrid gameGrid;
+
+    bool loaded;
+};
+
+struct PenguinsContext *createPenguinsContext(const char *playerName)
+{
+    struct PenguinsContext *context = (struct PenguinsContext *)malloc(sizeof(struct PenguinsContext));
+    if (context == NULL)
+        return NULL;
+
+    context->playerName = (char *)malloc(strlen(playerName) + 1);
+    if (context->playerName == NULL)
+    {
+        free(context);
+        return NULL;
+    }
+    strcpy(context->playerName, playerName);
+
+    resetPenguinsContext(context);
+    return context;
+}
+
+void destroyPenguinsContext(struct PenguinsContext *context)
+{
+    if (context == NULL)
+        return;
+
+    freeGameSystemObject(&context->game);
+    free(context->playerName);
+    free(context);
+}
+
+void resetPenguinsContext(struct PenguinsContext *context)
+{
+    context->game = createGameSystemObject();
+    context->game.myPlayer.name = context->playerName;
+
+    // boards come from memory, the grid never opens a file
+    context->gameGrid = createGameGridObject();
+    free(context->gameGrid.inputFile);
+    free(context->gameGrid.outputFile);
+    context->gameGrid.inputFile = NULL;
+    context->gameGrid.outputFile = NULL;
+
+    context->game.gameGrid = &context->gameGrid;
+    context->gameGrid.gameInstance = &context->game;
+
+    context->loaded = false;
+}
+
+enum ExceptionHandler loadPenguinsBoard(struct PenguinsContext *context, const void *data, size_t size)
+{
+    // every board starts a new game, players included
+    freeGameSystemObject(&context->game);
+    resetPenguinsContext(context);
+
+    enum ExceptionHandler loadStatus = loadGridData(&context->game.myPlayer, &context->gameGrid, (const unsigned char *)data, size);
+    context->loaded = loadStatus == NoError;
+
+    return loadStatus;
+}
+
+enum ExceptionHandler decidePenguinsAction(struct PenguinsContext *context, enum GameState phase, int numberOfPenguins,
+                                           struct PenguinsAction *action)
+{
+    if (!context->loaded)
+        return (enum ExceptionHandler)MoveImpossible;
+
+    struct GameSystem *game = &context->game;
+    game->phase = phase;
+    game->numberOfPenguins = phase == (enum GameState)PlacingPhase ? numberOfPenguins : -1;
+
+    struct GridPoint *from, *to;
+    enum ExceptionHandler decideStatus = game->decideAction(game, &from, &to);
+    if (decideStatus != NoError)
+        return decideStatus;
+
+    action->fromX = from != NULL ? from->x : -1;
+    action->fromY = from != NULL ? from->y : -1;
+    action->toX = to->x;
+    action->toY = to->y;
+    action->collectedFishes = to->numberOfFishes;
+
+    return game->playAction(game, from, to);
+}
+
+unsigned char *serialisePenguinsBoard(struct PenguinsContext *context, bool binary, size_t *size)
+{
+    if (!context->loaded)
+        return NULL;
+
+    return encodeGridData(&context->game.myPlayer, &context->gameGrid, binary, size);
+}
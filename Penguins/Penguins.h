@@ -0,0 +1,63 @@
+#ifndef PENGUINS_H
+#define PENGUINS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "../Enums/ExceptionHandler.h"
+#include "../Enums/GameState.h"
+
+// Embeddable engine (the libpenguins target): every game lives in its own context, boards are passed
+// in and out of memory and nothing is ever written to a file or to stdout, so a host can run any number
+// of contexts at once, each one from a single thread at a time. Errors are returned, never exit()ed on.
+//
+//   struct PenguinsContext *context = createPenguinsContext("Phasma");
+//   loadPenguinsBoard(context, text, textSize);                  // text or binary board
+//   decidePenguinsAction(context, MovementPhase, 0, &action);    // chosen and played on the board
+//   unsigned char *board = serialisePenguinsBoard(context, false, &boardSize);
+//   free(board);
+//   destroyPenguinsContext(context);
+
+// only the functions below are exported from the library, the engine itself stays hidden
+#if defined(_WIN32) && defined(PENGUINS_SHARED)
+#ifdef PENGUINS_LIBRARY
+#define PENGUINS_API __declspec(dllexport)
+#else
+#define PENGUINS_API __declspec(dllimport)
+#endif
+#elif defined(__GNUC__)
+#define PENGUINS_API __attribute__((visibility("default")))
+#else
+#define PENGUINS_API
+#endif
+
+struct PenguinsContext;
+
+// tiles are given as row x and column y like in the board files, a placement has fromX = fromY = -1
+struct PenguinsAction
+{
+    int fromX;
+    int fromY;
+    int toX;
+    int toY;
+    int collectedFishes;
+};
+
+// a context playing under the given name (it is looked up in the player table of every loaded board),
+// NULL if out of memory
+PENGUINS_API struct PenguinsContext *createPenguinsContext(const char *playerName);
+
+PENGUINS_API void destroyPenguinsContext(struct PenguinsContext *context);
+
+// replaces the board of the context with the given one, in the binary format or in the text format
+PENGUINS_API enum ExceptionHandler loadPenguinsBoard(struct PenguinsContext *context, const void *data, size_t size);
+
+// chooses our action on the loaded board and plays it, numberOfPenguins is the number of penguins
+// every player places (used only in the PlacingPhase)
+PENGUINS_API enum ExceptionHandler decidePenguinsAction(struct PenguinsContext *context, enum GameState phase, int numberOfPenguins,
+                                                        struct PenguinsAction *action);
+
+// the current board in the binary format or in the text format, in a buffer allocated with malloc
+// which belongs to the caller, NULL if no board is loaded
+PENGUINS_API unsigned char *serialisePenguinsBoard(struct PenguinsContext *context, bool binary, size_t *size);
+
+#endif
@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../GameSystem/GameSystem.h"
+#include "../GameGrid/Grid.h"
+#include "../GameGrid/BoardKernels.h"
+
+// times the straight-line scans used by the move finders on a board, from every tile in both directions:
+//   BoardBenchmark board.txt          (or board.bin)
+//   BoardBenchmark board.txt 500      number of passes over the board, 200 by default
+// rows and columns are reported both for walking the tiles of the grid and for the bit masks,
+// the columns use the transposed mirror of the masks (see GameGrid)
+
+// private functions:
+
+// first tile holding fishNumber fish before the first untraversable one, -1 if there is none
+int walkGrid(struct GameGrid *gameGrid, int x, int y, int dx, int dy, int fishNumber);
+int scanRow(struct GameGrid *gameGrid, int x, int y, int direction, int fishNumber);
+int scanColumn(struct GameGrid *gameGrid, int x, int y, int direction, int fishNumber);
+void report(const char *name, clock_t start, long scans, long checksum);
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        printf("usage: %s <board> [passes]\n", argv[0]);
+        return 3;
+    }
+
+    struct GameSystem *game = (struct GameSystem *)malloc(sizeof(struct GameSystem));
+    *game = createGameSystemObject();
+    game->gameGrid = (struct GameGrid *)malloc(sizeof(struct GameGrid));
+    *(game->gameGrid) = createGameGridObject();
+    game->gameGrid->gameInstance = game;
+
+    struct GameGrid *gameGrid = game->gameGrid;
+    snprintf(gameGrid->inputFile, 100, "%s", argv[1]);
+    if (gameGrid->readGridData(&game->myPlayer, gameGrid) != (enum ExceptionHandler)NoError)
+    {
+        printf("\nunable to read the board %s\n", argv[1]);
+        return 3;
+    }
+
+    const int passes = argc == 3 ? atoi(argv[2]) : 200;
+    const long scans = 2L * passes * gameGrid->rows * gameGrid->cols;
+    printf("\n%d x %d board, row kernels %s, column kernels %s, %ld scans per path\n", gameGrid->rows, gameGrid->cols,
+           gameGrid->kernels->name, gameGrid->columnKernels->name, scans);
+
+    long checksum = 0;
+    clock_t start = clock();
+    for (int pass = 0; pass < passes; pass++)
+        for (int x = 0; x < gameGrid->rows; x++)
+            for (int y = 0; y < gameGrid->cols; y++)
+                checksum += walkGrid(gameGrid, x, y, 0, 1, 3) + walkGrid(gameGrid, x, y, 0, -1, 3);
+    report("rows, grid walk", start, scans, checksum);
+
+    checksum = 0;
+    start = clock();
+    for (int pass = 0; pass < passes; pass++)
+        for (int x = 0; x < gameGrid->rows; x++)
+            for (int y = 0; y < gameGrid->cols; y++)
+                checksum += scanRow(gameGrid, x, y, 1, 3) + scanRow(gameGrid, x, y, -1, 3);
+    report("rows, masks", start, scans, checksum);
+
+    checksum = 0;
+    start = clock();
+    for (int pass = 0; pass < passes; pass++)
+        for (int x = 0; x < gameGrid->rows; x++)
+            for (int y = 0; y < gameGrid->cols; y++)
+                checksum += walkGrid(gameGrid, x, y, 1, 0, 3) + walkGrid(gameGrid, x, y, -1, 0, 3);
+    report("columns, grid walk", start, scans, checksum);
+
+    checksum = 0;
+    start = clock();
+    for (int pass = 0; pass < passes; pass++)
+        for (int x = 0; x < gameGrid->rows; x++)
+            for (int y = 0; y < gameGrid->cols; y++)
+                checksum += scanColumn(gameGrid, x, y, 1, 3) + scanColumn(gameGrid, x, y, -1, 3);
+    report("columns, masks", start, scans, checksum);
+
+    return 0;
+}
+
+int walkGrid(struct GameGrid *gameGrid, int x, int y, int dx, int dy, int fishNumber)
+{
+    for (int i = x + dx, j = y + dy; i >= 0 && i < gameGrid->rows && j >= 0 && j < gameGrid->cols; i += dx, j += dy)
+    {
+        const struct GridPoint *p = &gameGrid->grid[i][j];
+        if (p->owner != &gameGrid->gameInstance->myPlayer && p->numberOfFishes == 0)
+            return -1;
+        if (p->numberOfFishes == fishNumber)
+            return dx == 0 ? j : i;
+    }
+    return -1;
+}
+
+int scanRow(struct GameGrid *gameGrid, int x, int y, int direction, int fishNumber)
+{
+    const int ourId = gameGrid->gameInstance->myPlayer.id;
+    if (ourId < 0 || ourId > MAX_PLAYER_ID)
+        return -1;
+
+    const int row = x * gameGrid->maskWords;
+    return gameGrid->kernels->findInRow(gameGrid->fishMasks[0] + row, gameGrid->penguinMasks[ourId] + row,
+                                        gameGrid->fishMasks[fishNumber] + row, gameGrid->cols, gameGrid->maskWords, y, direction);
+}
+
+int scanColumn(struct GameGrid *gameGrid, int x, int y, int direction, int fishNumber)
+{
+    const int ourId = gameGrid->gameInstance->myPlayer.id;
+    if (ourId < 0 || ourId > MAX_PLAYER_ID)
+        return -1;
+
+    const int column = y * gameGrid->columnWords;
+    return gameGrid->columnKernels->findInRow(gameGrid->fishColumnMasks[0] + column, gameGrid->penguinColumnMasks[ourId] + column,
+                                              gameGrid->fishColumnMasks[fishNumber] + column, gameGrid->rows,
+                                              gameGrid->columnWords, x, direction);
+}
+
+void report(const char *name, clock_t start, long scans, long checksum)
+{
+    const double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%-20s %8.2f ns per scan (checksum %ld)\n", name, scans > 0 ? seconds * 1e9 / scans : 0.0, checksum);
+}
@@ -0,0 +1,25 @@
+#include <stdio.h>
+#include "../GameGrid/BinaryBoard.h"
+
+// converts a board between the text format and the binary one,
+// the direction is picked from the extension of the input file:
+//   BoardConverter board.txt board.bin
+//   BoardConverter board.bin board.txt
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        printf("usage: %s <input board> <output board>\n", argv[0]);
+        return 3;
+    }
+
+    enum ExceptionHandler status = hasBinaryBoardExtension(argv[1]) ? convertBinaryBoardToText(argv[1], argv[2])
+                                                                    : convertTextBoardToBinary(argv[1], argv[2]);
+    if (status != (enum ExceptionHandler)NoError)
+    {
+        printf("conversion failed with error %d\n", status);
+        return 3;
+    }
+
+    return 0;
+}
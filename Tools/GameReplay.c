@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "../GameRecord/GameRecord.h"
+
+// replays a game record written next to the output board:
+//   GameReplay out.txt.record                 lists every recorded position
+//   GameReplay out.txt.record 12              prints position 12 in the text format
+//   GameReplay out.txt.record 12 board.bin    writes position 12 as a board file (.txt or .bin)
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 4)
+    {
+        printf("usage: %s <record> [ply] [output board]\n", argv[0]);
+        return 3;
+    }
+
+    struct GameRecordReader reader;
+    if (openGameRecord(argv[1], &reader) != (enum ExceptionHandler)NoError)
+    {
+        printf("unable to read the record %s\n", argv[1]);
+        return 3;
+    }
+
+    if (argc == 2)
+    {
+        do
+        {
+            printf("%d %c player %d:", reader.ply, (char)reader.lastFrameType, reader.lastPlayerId);
+            for (int i = 0; i < reader.position.numberOfPlayers; i++)
+            {
+                printf(" %s=%d", reader.position.players[i].name, reader.position.players[i].collectedFishes);
+            }
+            printf("\n");
+        } while (readNextGameRecordFrame(&reader));
+
+        closeGameRecord(&reader);
+        return 0;
+    }
+
+    const int ply = atoi(argv[2]);
+    while (reader.ply < ply && readNextGameRecordFrame(&reader))
+        ;
+
+    if (reader.ply != ply)
+    {
+        printf("the record has only %d positions\n", reader.ply + 1);
+        closeGameRecord(&reader);
+        return 3;
+    }
+
+    enum ExceptionHandler status = (enum ExceptionHandler)NoError;
+    if (argc == 4)
+    {
+        status = hasBinaryBoardExtension(argv[3]) ? writeBinaryBoard(argv[3], &reader.position) : writeTextBoard(argv[3], &reader.position);
+    }
+    else
+    {
+        printTextBoard(stdout, &reader.position);
+    }
+
+    closeGameRecord(&reader);
+    return status == (enum ExceptionHandler)NoError ? 0 : 3;
+}
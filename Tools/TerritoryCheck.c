@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../GameSystem/GameSystem.h"
+#include "../GameSystem/MoveStack.h"
+#include "../GameGrid/Grid.h"
+#include "../Evaluation/TerritoryReference.h"
+#include "../Evaluation/TerritoryBatch.h"
+
+// checks that the batch evaluation (Evaluation/TerritoryBatch.h) scores every candidate exactly like
+// the scalar one (Evaluation/TerritoryReference.h) does after playing the candidate on the grid, on random boards
+// of every width class of the board kernels:
+//   TerritoryCheck              10 boards of every width
+//   TerritoryCheck 100 7        100 boards of every width, random seed 7
+// returns 1 if any score differs
+
+// private functions:
+
+// a random board in the text format with penguins of numberOfPlayers players, our player is the first one
+char *randomBoard(int rows, int cols, int numberOfPlayers, size_t *size);
+
+// every movement of every penguin and a few placements of every player
+int listCandidates(struct GameGrid *gameGrid, int numberOfPlayers, struct TerritoryCandidate *candidates);
+
+// number of candidates whose batch score differs from the scalar one
+int checkBoard(int rows, int cols, int numberOfPlayers);
+
+int main(int argc, char *argv[])
+{
+    if (argc > 3)
+    {
+        printf("usage: %s [boards] [seed]\n", argv[0]);
+        return 3;
+    }
+
+    const int boards = argc >= 2 ? atoi(argv[1]) : 10;
+    srand(argc == 3 ? (unsigned)atoi(argv[2]) : 1u);
+
+    // below, at and above the limits of the 32, 64 and 128 column kernels
+    const int widths[] = {1, 7, 32, 33, 64, 65, 100, 128, 129, 200};
+    int mismatches = 0;
+    for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++)
+    {
+        for (int b = 0; b < boards; b++)
+        {
+            mismatches += checkBoard(1 + rand() % 16, widths[w], 2 + rand() % 3);
+        }
+    }
+
+    printf("\n%d mismatching scores\n", mismatches);
+    return mismatches ? 1 : 0;
+}
+
+char *randomBoard(int rows, int cols, int numberOfPlayers, size_t *size)
+{
+    char *text = (char *)malloc(32 + (size_t)rows * (3 * cols + 1) + numberOfPlayers * 32);
+    *size = sprintf(text, "%d %d\n", rows, cols);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < cols; j++)
+        {
+            // mostly fish, some water and a few penguins
+            const int r = rand() % 20;
+            if (r < 1)
+                *size += sprintf(text + *size, "0%d ", 1 + rand() % numberOfPlayers);
+            else if (r < 5)
+                *size += sprintf(text + *size, "00 ");
+            else
+                *size += sprintf(text + *size, "%d0 ", 1 + rand() % 3);
+        }
+        text[*size - 1] = '\n';
+    }
+
+    *size += sprintf(text + *size, "Phasma 1 0\n");
+    for (int id = 2; id <= numberOfPlayers; id++)
+    {
+        *size += sprintf(text + *size, "player%d %d 0\n", id, id);
+    }
+    return text;
+}
+
+int listCandidates(struct GameGrid *gameGrid, int numberOfPlayers, struct TerritoryCandidate *candidates)
+{
+    const int directions[4][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
+    int numberOfCandidates = 0;
+
+    for (int id = 1; id <= numberOfPlayers; id++)
+    {
+        for (int k = 0; k < gameGrid->numberOfPenguinsOf[id]; k++)
+        {
+            const struct GridPoint *from = gameGrid->penguins[id][k];
+            for (int d = 0; d < 4; d++)
+            {
+                for (int x = from->x + directions[d][0], y = from->y + directions[d][1];
+                     x >= 0 && y >= 0 && x < gameGrid->rows && y < gameGrid->cols && gameGrid->grid[x][y].numberOfFishes > 0 &&
+                     gameGrid->grid[x][y].owner == NULL;
+                     x += directions[d][0], y += directions[d][1])
+                {
+                    candidates[numberOfCandidates].from = from;
+                    candidates[numberOfCandidates].to = &gameGrid->grid[x][y];
+                    candidates[numberOfCandidates].playerId = id;
+                    numberOfCandidates++;
+                }
+            }
+        }
+
+        // placements on the first free tiles
+        for (int i = 0, placed = 0; i < gameGrid->rows * gameGrid->cols && placed < 5; i++)
+        {
+            const struct GridPoint *to = &gameGrid->grid[i / gameGrid->cols][i % gameGrid->cols];
+            if (to->numberOfFishes != 1 || to->owner != NULL)
+                continue;
+            candidates[numberOfCandidates].from = NULL;
+            candidates[numberOfCandidates].to = to;
+            candidates[numberOfCandidates].playerId = id;
+            numberOfCandidates++;
+            placed++;
+        }
+    }
+    return numberOfCandidates;
+}
+
+int checkBoard(int rows, int cols, int numberOfPlayers)
+{
+    struct GameSystem game = createGameSystemObject();
+    struct GameGrid gameGrid = createGameGridObject();
+    free(gameGrid.inputFile);
+    free(gameGrid.outputFile);
+    gameGrid.inputFile = NULL;
+    gameGrid.outputFile = NULL;
+    game.gameGrid = &gameGrid;
+    gameGrid.gameInstance = &game;
+
+    size_t size;
+    char *text = randomBoard(rows, cols, numberOfPlayers, &size);
+    if (loadGridData(&game.myPlayer, &gameGrid, (const unsigned char *)text, size) != NoError)
+    {
+        printf("\nunable to load a %d x %d board\n", rows, cols);
+        free(text);
+        freeGameSystemObject(&game);
+        return 1;
+    }
+    free(text);
+
+    // the four lines of a penguin hold at most rows + cols tiles
+    int numberOfPenguins = 0;
+    for (int id = 0; id <= MAX_PLAYER_ID; id++)
+        numberOfPenguins += gameGrid.numberOfPenguinsOf[id];
+    const int maxCandidates = numberOfPenguins * (rows + cols) + numberOfPlayers * 5;
+    struct TerritoryCandidate *candidates = (struct TerritoryCandidate *)malloc(maxCandidates * sizeof(struct TerritoryCandidate));
+    const int numberOfCandidates = listCandidates(&gameGrid, numberOfPlayers, candidates);
+
+    struct TerritoryScore *scores = (struct TerritoryScore *)malloc((numberOfCandidates + 1) * sizeof(struct TerritoryScore));
+    struct TerritoryBatchEvaluator batchEvaluator = createTerritoryBatchEvaluatorObject(rows, cols);
+    evaluateTerritoryBatch(&batchEvaluator, &gameGrid, candidates, numberOfCandidates, scores);
+
+    // the scalar evaluation of every candidate played on the grid, placements need a player of the right id
+    struct Player players[MAX_PLAYER_ID + 1];
+    for (int id = 0; id <= MAX_PLAYER_ID; id++)
+    {
+        players[id] = createPlayerObject();
+        players[id].id = id;
+    }
+    struct TerritoryEvaluator evaluator = createTerritoryEvaluatorObject(rows, cols);
+    struct MoveStack stack = createMoveStackObject(1);
+    int mismatches = 0;
+    for (int i = 0; i < numberOfCandidates; i++)
+    {
+        struct GridPoint *from = (struct GridPoint *)candidates[i].from;
+        struct GridPoint *to = (struct GridPoint *)candidates[i].to;
+        if (from == NULL)
+            makePlacement(&stack, &gameGrid, &players[candidates[i].playerId], to);
+        else
+            makeMove(&stack, &gameGrid, from->owner, from, to);
+
+        struct TerritoryScore score;
+        evaluateTerritory(&evaluator, &gameGrid, &score);
+        unmakeMove(&stack, &gameGrid);
+
+        if (memcmp(&score, &scores[i], sizeof(score)))
+        {
+            printf("\n%d x %d board: candidate %d of player %d scored differently\n", rows, cols, i, candidates[i].playerId);
+            mismatches++;
+        }
+    }
+
+    freeMoveStackObject(&stack);
+    freeTerritoryEvaluatorObject(&evaluator);
+    freeTerritoryBatchEvaluatorObject(&batchEvaluator);
+    free(scores);
+    free(candidates);
+    freeGameSystemObject(&game);
+    return mismatches;
+}
@@ -2,6 +2,50 @@
 #include <stdlib.h>
 #include "./GameSystem/GameSystem.h"
 
+// the engine only reports errors, ending the process is up to the executable
+void exitWithErrorMessage(enum ExceptionHandler error)
+{
+    // MessageBeep(MB_ICONEXCLAMATION);
+
+    switch (error)
+    {
+    case UnknownParamsException:
+    {
+        // MessageBox(NULL, "Unsupported command line parameters", "Error", MB_ICONWARNING);
+        exit(3);
+    }
+    case PenguinsNumValueException:
+    {
+        // MessageBox(NULL, "Unsupported number of penguins", "Error", MB_ICONWARNING);
+        exit(3);
+    }
+    case GamePhaseValueException:
+    {
+        // MessageBox(NULL, "Invalid game phase (should be: movement/placement)", "Error", MB_ICONWARNING);
+        exit(3);
+    }
+    case FileFormatException:
+    {
+        // MessageBox(NULL, "Invalid file format. Only .txt and .bin are supported", "Error", MB_ICONWARNING);
+        exit(3);
+    }
+    case FileOpenException:
+    {
+        // MessageBox(NULL, "Error while opening the file. Please provide a valid path (relative to the .exe file)", "Error", MB_ICONWARNING);
+        exit(3);
+    }
+    case MoveImpossible:
+    {
+        // MessageBox(NULL, "Impossible to make a move for current phase", "Error", MB_ICONWARNING);
+        exit(3);
+    }
+    default:
+    {
+        break;
+    }
+    }
+}
+
 int main(int argc, char *argv[])
 {
     struct GameSystem *gameSystem = (struct GameSystem *)malloc(sizeof(struct GameSystem));
@@ -15,14 +59,20 @@ int main(int argc, char *argv[])
     enum ExceptionHandler setupStatus = gameSystem->setup(gameSystem, argc, argv);
     if (setupStatus != (enum ExceptionHandler)NoError)
     {
-        gameSystem->exitWithErrorMessage(setupStatus);
+        exitWithErrorMessage(setupStatus);
+    }
+
+    // only our name was asked for
+    if (gameSystem->phase == (enum GameState)Unset)
+    {
+        return 0;
     }
 
     enum ExceptionHandler actionStatus = gameSystem->performAction(gameSystem);
     if (actionStatus != (enum ExceptionHandler)NoError)
     {
-        gameSystem->exitWithErrorMessage(actionStatus);
+        exitWithErrorMessage(actionStatus);
     }
 
     return 0;
-}
\ No newline at end of file
+}